@@ -23,16 +23,23 @@
 // 3. This notice may not be removed or altered from any source distribution.  //
 //-----------------------------------------------------------------------------//
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
+#include <functional>
 #include <future>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <type_traits>
@@ -45,9 +52,17 @@
 #endif
 
 #include "tools/async_observer.hpp"
+#include "tools/concurrent_histogram.hpp"
 #include "tools/expected.hpp"
+#include "tools/frame_arena.hpp"
+#include "tools/hdr_histogram.hpp"
+#include "tools/heavy_hitters.hpp"
 #include "tools/histogram.hpp"
 #include "tools/lock_free_ring_buffer.hpp"
+#include "tools/mem_pool_allocator.hpp"
+#include "tools/mem_pool_resource.hpp"
+#include "tools/mem_pool_trimmer.hpp"
+#include "tools/periodic_scheduler.hpp"
 #include "tools/periodic_task.hpp"
 #include "tools/ring_buffer.hpp"
 #include "tools/ring_vector.hpp"
@@ -59,9 +74,12 @@
 #include "tools/sync_ring_vector.hpp"
 #include "tools/sync_time_list.hpp"
 #include "tools/time_list.hpp"
+#include "tools/windowed_histogram.hpp"
 #include "tools/worker_task.hpp"
 
 #include "portable_concurrency/p_latch.hpp"
+#include "portable_concurrency/p_stop_token.hpp"
+#include "portable_concurrency/p_task.hpp"
 #include "portable_concurrency/p_thread_pool.hpp"
 #include "portable_concurrency/p_timed_waiter.hpp"
 
@@ -1281,6 +1299,292 @@ void test_histogram()
     std::cout << "hist total count: " << hist.total_count() << std::endl;
     std::cout << "hist top value: " << hist.top() << " (" << hist.top_occurence() << " times)" << std::endl;
     std::cout << "hist avg: " << avg << " median: " << hist.median() << " variance: " << var << std::endl;
+    std::cout << "hist running moments: stddev: " << hist.standard_deviation() << " skewness: " << hist.skewness()
+              << " kurtosis: " << hist.kurtosis() << std::endl;
+}
+
+void test_histogram_non_arithmetic()
+{
+    std::cout << "-- histogram non arithmetic --" << std::endl;
+    tools::histogram<std::string> hist;
+
+    hist.add("alpha");
+    hist.add(std::string("beta"));
+    hist.emplace(4U, 'z');
+
+    const std::vector<std::string> words = { "beta", "gamma", "beta" };
+    hist.add_range(words.begin(), words.end());
+    hist.add_bulk(words.data(), words.size());
+
+    std::cout << "hist total count: " << hist.total_count() << ", top value: " << hist.top() << " ("
+              << hist.top_occurence() << " times)" << std::endl;
+}
+
+void test_histogram_batch_kernels()
+{
+    std::cout << "-- histogram batch kernels --" << std::endl;
+
+    constexpr std::size_t nb_samples = 200000U;
+    std::mt19937 generator(7U);
+    std::normal_distribution<double> signal(10.0, 2.0);
+
+    // values quantized to 0.1 so that the histogram has repeated keys
+    std::vector<double> samples(nb_samples);
+    std::generate(samples.begin(), samples.end(), [&]() { return std::round(signal(generator) * 10.0) / 10.0; });
+
+    auto elapsed_us = [](const auto& job)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        job();
+        const auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    };
+
+    // binning: one add per value vs bulk insertion
+    tools::histogram<double> scalar_hist;
+    tools::histogram<double> bulk_hist;
+    const auto scalar_add_us = elapsed_us(
+        [&]()
+        {
+            for (const double value : samples)
+            {
+                scalar_hist.add(value);
+            }
+        });
+    const auto bulk_add_us = elapsed_us([&]() { bulk_hist.add_bulk(samples.data(), samples.size()); });
+
+    std::cout << "add: " << scalar_add_us << " us, add_bulk: " << bulk_add_us << " us" << std::endl;
+    std::cout << "scalar avg: " << scalar_hist.average() << " stddev: " << scalar_hist.standard_deviation()
+              << " kurtosis: " << scalar_hist.kurtosis() << " top: " << scalar_hist.top() << std::endl;
+    std::cout << "bulk   avg: " << bulk_hist.average() << " stddev: " << bulk_hist.standard_deviation()
+              << " kurtosis: " << bulk_hist.kurtosis() << " top: " << bulk_hist.top() << std::endl;
+
+    // densities: scalar calls vs batch kernel
+    const double avg = bulk_hist.average();
+    const double std_deviation = bulk_hist.standard_deviation();
+    std::vector<double> densities(nb_samples);
+    double scalar_sum = 0.0;
+    const auto scalar_density_us = elapsed_us(
+        [&]()
+        {
+            for (std::size_t i = 0U; i < nb_samples; ++i)
+            {
+                densities[i] = bulk_hist.gaussian_density(samples[i], avg, std_deviation);
+            }
+            scalar_sum = std::accumulate(densities.begin(), densities.end(), 0.0);
+        });
+    double batch_sum = 0.0;
+    const auto batch_density_us = elapsed_us(
+        [&]()
+        {
+            bulk_hist.gaussian_density_batch(samples.data(), nb_samples, densities.data(), avg, std_deviation);
+            batch_sum = std::accumulate(densities.begin(), densities.end(), 0.0);
+        });
+
+    std::cout << "gaussian_density: " << scalar_density_us << " us (sum " << scalar_sum
+              << "), gaussian_density_batch: " << batch_density_us << " us (sum " << batch_sum << ")" << std::endl;
+
+    // interval probability: Monte Carlo vs closed form
+    double montecarlo = 0.0;
+    double closed_form = 0.0;
+    const auto montecarlo_us
+        = elapsed_us([&]() { montecarlo = bulk_hist.gaussian_probability(8.0, 12.0, avg, std_deviation, 100000); });
+    const auto closed_form_us
+        = elapsed_us([&]() { closed_form = bulk_hist.gaussian_interval_probability(8.0, 12.0, avg, std_deviation); });
+
+    std::cout << "P[8,12] monte carlo: " << montecarlo << " (" << montecarlo_us << " us), erf: " << closed_form << " ("
+              << closed_form_us << " us)" << std::endl;
+}
+
+void display_hdr_percentiles(const tools::hdr_histogram& hist)
+{
+    std::cout << "count: " << hist.total_count() << " min: " << hist.min() << " mean: " << hist.mean()
+              << " p50: " << hist.percentile(50.0) << " p99: " << hist.percentile(99.0)
+              << " p99.9: " << hist.percentile(99.9) << " max: " << hist.max() << std::endl;
+}
+
+void test_hdr_histogram()
+{
+    std::cout << "-- hdr histogram --" << std::endl;
+
+    // mocked latencies (us): exponential body with a rare slow path
+    constexpr std::size_t nb_samples = 1000000U;
+    std::mt19937 generator(42U);
+    std::exponential_distribution<double> body(1.0 / 50.0);
+    std::uniform_int_distribution<int> slow_path(0, 999);
+
+    std::vector<std::uint64_t> samples;
+    samples.reserve(nb_samples);
+    for (std::size_t i = 0U; i < nb_samples; ++i)
+    {
+        const double latency = body(generator) + ((0 == slow_path(generator)) ? 5000.0 : 0.0);
+        samples.push_back(static_cast<std::uint64_t>(latency));
+    }
+
+    tools::hdr_histogram first_half;
+    tools::hdr_histogram second_half;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    const auto middle = samples.begin() + static_cast<std::ptrdiff_t>(nb_samples / 2U);
+    std::for_each(samples.begin(), middle, [&first_half](std::uint64_t value) { first_half.record(value); });
+    std::for_each(middle, samples.end(), [&second_half](std::uint64_t value) { second_half.record(value); });
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << "recorded " << nb_samples << " samples in "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us ("
+              << first_half.bucket_count() << " buckets)" << std::endl;
+
+    // lossless merge of the two halves
+    tools::hdr_histogram merged = first_half;
+    const bool merge_ok = merged.merge(second_half);
+    std::cout << "merge: " << (merge_ok ? "ok" : "layout mismatch") << std::endl;
+    display_hdr_percentiles(merged);
+
+    // exact percentiles for comparison
+    std::sort(samples.begin(), samples.end());
+    std::cout << "exact p50: " << samples[(nb_samples / 2U) - 1U] << " p99: " << samples[((nb_samples * 99U) / 100U) - 1U]
+              << " p99.9: " << samples[((nb_samples * 999U) / 1000U) - 1U] << std::endl;
+}
+
+void test_concurrent_histogram()
+{
+    std::cout << "-- concurrent histogram --" << std::endl;
+
+    constexpr int nb_threads = 4;
+    constexpr std::uint64_t samples_per_thread = 250000U;
+
+    // lock-free recording, one single-writer shard per thread
+    tools::concurrent_histogram sharded;
+    auto sharded_worker = [&sharded](int thread_id)
+    {
+        for (std::uint64_t i = 0U; i < samples_per_thread; ++i)
+        {
+            sharded.record(((i * 7919U) + static_cast<std::uint64_t>(thread_id)) % 1000U);
+        }
+    };
+
+    // reference: a single histogram behind a mutex
+    tools::hdr_histogram locked;
+    std::mutex locked_mutex;
+    auto locked_worker = [&locked, &locked_mutex](int thread_id)
+    {
+        for (std::uint64_t i = 0U; i < samples_per_thread; ++i)
+        {
+            std::lock_guard<std::mutex> guard(locked_mutex);
+            locked.record(((i * 7919U) + static_cast<std::uint64_t>(thread_id)) % 1000U);
+        }
+    };
+
+    auto run_workers = [](const auto& worker)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (int thread_id = 0; thread_id < nb_threads; ++thread_id)
+        {
+            threads.emplace_back(worker, thread_id);
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    };
+
+    const auto sharded_us = run_workers(sharded_worker);
+    const auto locked_us = run_workers(locked_worker);
+
+    std::cout << "sharded (" << sharded.shard_count() << " shards): " << sharded_us << " us, mutex: " << locked_us
+              << " us" << std::endl;
+
+    const auto snapshot = sharded.snapshot();
+    display_hdr_percentiles(snapshot);
+    display_hdr_percentiles(locked);
+}
+
+void test_windowed_histogram()
+{
+    std::cout << "-- windowed histogram --" << std::endl;
+
+    // 10 slices of 100 ms: rolling percentiles over the last 1 s at most
+    const auto slice_duration = std::chrono::duration<int, std::micro>(100000);
+    auto window = std::make_shared<tools::windowed_histogram>(slice_duration, 10U);
+
+    auto rotate = [](std::shared_ptr<tools::windowed_histogram> context, const std::string& task_name) -> void
+    {
+        (void)task_name;
+        context->rotate();
+    };
+
+    {
+        tools::periodic_task<tools::windowed_histogram> rotation(rotate, window, "window rotation", slice_duration);
+
+        std::mt19937 generator(3U);
+        std::exponential_distribution<double> fast(1.0 / 100.0);
+        std::exponential_distribution<double> slow(1.0 / 1000.0);
+
+        // 500 ms of fast responses followed by 300 ms of slow responses
+        const auto start = std::chrono::steady_clock::now();
+        while ((std::chrono::steady_clock::now() - start) < std::chrono::milliseconds(800))
+        {
+            const bool slow_phase = (std::chrono::steady_clock::now() - start) >= std::chrono::milliseconds(500);
+            for (int i = 0; i < 100; ++i)
+            {
+                window->record(static_cast<std::uint64_t>(slow_phase ? slow(generator) : fast(generator)));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    const auto last_200ms = window->snapshot(std::chrono::duration<int, std::micro>(200000));
+    const auto last_1s = window->snapshot(std::chrono::duration<int, std::micro>(1000000));
+
+    std::cout << "rotations: " << window->rotations() << std::endl;
+    std::cout << "last 200 ms: ";
+    display_hdr_percentiles(last_200ms);
+    std::cout << "last 1 s:    ";
+    display_hdr_percentiles(last_1s);
+}
+
+void test_heavy_hitters()
+{
+    std::cout << "-- heavy hitters --" << std::endl;
+
+    // zipf-like stream over 1000 topics, tracked with 32 counters
+    constexpr std::size_t nb_topics = 1000U;
+    constexpr std::size_t nb_events = 200000U;
+
+    std::vector<std::string> topics;
+    std::vector<double> weights;
+    for (std::size_t i = 0U; i < nb_topics; ++i)
+    {
+        topics.emplace_back("topic_" + std::to_string(i));
+        weights.push_back(1.0 / static_cast<double>(i + 1U));
+    }
+
+    std::mt19937 generator(5U);
+    std::discrete_distribution<std::size_t> distribution(weights.begin(), weights.end());
+
+    tools::heavy_hitters<std::string> hottest(32U);
+    std::vector<std::uint64_t> exact(nb_topics, 0U);
+
+    for (std::size_t i = 0U; i < nb_events; ++i)
+    {
+        const auto topic = distribution(generator);
+        hottest.add(topics[topic]);
+        ++exact[topic];
+    }
+
+    std::cout << "events: " << hottest.total() << " monitored: " << hottest.size() << "/" << hottest.capacity()
+              << std::endl;
+
+    for (const auto& hitter : hottest.top(5U))
+    {
+        const auto topic = std::stoul(hitter.key.substr(hitter.key.find('_') + 1U));
+        const bool bounded = (hitter.count >= exact[topic]) && ((hitter.count - hitter.error) <= exact[topic]);
+        std::cout << hitter.key << ": estimate " << hitter.count << " (error <= " << hitter.error << ") exact "
+                  << exact[topic] << (bounded ? "" : " OUT OF BOUNDS") << std::endl;
+    }
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -1427,6 +1731,89 @@ void test_publish_subscribe()
     subject2->publish(my_topic::system, "tantine");
 }
 
+void test_mem_pool_resource()
+{
+    std::cout << "-- mem pool memory resource --" << std::endl;
+
+    // subject, async observer queue and command queue opt in to the mem pool without a global new/delete override
+    auto* pool_resource = tools::mem_pool_memory_resource();
+
+    using pool_async_observer = tools::async_observer<my_topic, std::string, tools::pmr_sync_queue>;
+    auto observer = std::make_shared<pool_async_observer>(pool_resource);
+    using pool_subject = tools::pmr_sync_subject<my_topic, std::string>;
+    auto subject = std::make_shared<pool_subject>("pool source", pool_resource);
+
+    subject->subscribe(my_topic::generic, observer);
+    subject->subscribe(my_topic::generic, "pool_handler",
+        [](const my_topic& topic, const std::string& event, const std::string& origin)
+        {
+            std::cout << "pool handler [topic " << static_cast<std::underlying_type<my_topic>::type>(topic)
+                      << "] received: event (" << event << ") from " << origin << std::endl;
+        });
+
+    subject->publish(my_topic::generic, "pooled event 1");
+    subject->publish(my_topic::generic, "pooled event 2");
+
+    for (const auto& [topic, event, origin] : observer->pop_all_events())
+    {
+        std::cout << "pool async observer [topic " << static_cast<std::underlying_type<my_topic>::type>(topic)
+                  << "] received: event (" << event << ") from " << origin << std::endl;
+    }
+
+    tools::pmr_sync_queue<int> int_queue(pool_resource);
+    for (int i = 0; i < 100; ++i)
+    {
+        int_queue.push(i);
+    }
+    std::cout << "pool queue size: " << int_queue.size() << std::endl;
+
+    // per-thread monotonic arena: scratch storage released in one go
+    {
+        std::pmr::vector<std::uint64_t> scratch(tools::thread_arena_memory_resource());
+        for (std::uint64_t i = 0U; i < 1000U; ++i)
+        {
+            scratch.push_back(i * i);
+        }
+        std::cout << "arena scratch sum: " << std::accumulate(scratch.begin(), scratch.end(), std::uint64_t { 0U })
+                  << std::endl;
+    }
+    tools::release_thread_arena();
+
+    tools::dump_mem_pool_stats(std::cout, tools::mem_pool_stats());
+}
+
+void test_mem_pool_trimming()
+{
+    std::cout << "-- mem pool trimming --" << std::endl;
+
+    tools::mem_pool_trimmer trimmer(std::chrono::duration<int, std::micro>(100000));
+
+    constexpr std::size_t burst_blocks = 2000U;
+    constexpr std::size_t block_size = 4096U;
+
+    // burst: the size class grows to the peak working set
+    std::vector<void*> blocks;
+    blocks.reserve(burst_blocks);
+    for (std::size_t i = 0U; i < burst_blocks; ++i)
+    {
+        blocks.push_back(tools::mem_pool_allocate(block_size));
+    }
+
+    std::cout << "after burst: slab chunks " << tools::mem_pool_stats().slab_chunks << std::endl;
+
+    for (void* block : blocks)
+    {
+        tools::mem_pool_deallocate(block, block_size);
+    }
+    blocks.clear();
+
+    // idle period: the target decays and the cold slab chunks go back to the system
+    std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(2000));
+
+    std::cout << "after idle: slab chunks " << tools::mem_pool_stats().slab_chunks << ", trim passes "
+              << trimmer.passes() << ", released bytes " << trimmer.released_bytes() << std::endl;
+}
+
 //--------------------------------------------------------------------------------------------------------------------------------
 
 struct my_periodic_task_context
@@ -1437,6 +1824,25 @@ struct my_periodic_task_context
 
 using my_periodic_task = tools::periodic_task<my_periodic_task_context>;
 
+void display_periodic_task_stats(const tools::periodic_task_stats& stats)
+{
+    std::cout << "ticks: " << stats.ticks << " overruns: " << stats.overruns
+              << " missed deadlines: " << stats.missed_deadlines << " skipped ticks: " << stats.skipped_ticks
+              << std::endl;
+    std::cout << "max lateness: " << stats.max_lateness.count() << " us, max duration: " << stats.max_duration.count()
+              << " us" << std::endl;
+
+    for (std::size_t i = 0U; i < tools::periodic_task_stats::histogram_buckets; ++i)
+    {
+        if ((stats.lateness_histogram[i] > 0U) || (stats.duration_histogram[i] > 0U))
+        {
+            std::cout << "< " << tools::periodic_task_stats::bucket_upper_bound(i)
+                      << " us: lateness=" << stats.lateness_histogram[i] << " duration=" << stats.duration_histogram[i]
+                      << std::endl;
+        }
+    }
+}
+
 void test_periodic_task()
 {
     std::cout << "-- periodic task --" << std::endl;
@@ -1457,6 +1863,26 @@ void test_periodic_task()
     std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(2000));
 
     std::cout << "nb of periodic loops = " << context->loop_counter.load() << std::endl;
+    display_periodic_task_stats(task1.stats());
+
+    {
+        // routine running longer than its period: missed ticks are skipped instead of drifting
+        auto slow_lambda = [](std::shared_ptr<my_periodic_task_context> ctx, const std::string& task_name) -> void
+        {
+            (void)task_name;
+            ctx->loop_counter += 1;
+            std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(30));
+        };
+
+        auto slow_context = std::make_shared<my_periodic_task_context>();
+        my_periodic_task slow_task(
+            slow_lambda, slow_context, "periodic task 2", period, tools::periodic_overrun_policy::skip_missed);
+
+        std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(500));
+
+        std::cout << "nb of overrunning periodic loops = " << slow_context->loop_counter.load() << std::endl;
+        display_periodic_task_stats(slow_task.stats());
+    }
 
     auto previous_timepoint = start_timepoint;
     while (!context->time_points.empty())
@@ -1475,6 +1901,86 @@ void test_periodic_task()
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
+const char* realtime_policy_name(tools::realtime_policy policy)
+{
+    switch (policy)
+    {
+        case tools::realtime_policy::deadline:
+            return "SCHED_DEADLINE";
+        case tools::realtime_policy::fifo:
+            return "SCHED_FIFO";
+        case tools::realtime_policy::round_robin:
+            return "SCHED_RR";
+        case tools::realtime_policy::idle:
+            return "SCHED_IDLE";
+        case tools::realtime_policy::none:
+        default:
+            return "none";
+    }
+}
+
+void display_realtime_report(const tools::realtime_report& report)
+{
+    std::cout << "policy: " << realtime_policy_name(report.applied_policy)
+              << " priority: " << report.applied_priority << " memory locked: " << report.memory_locked
+              << " prefaulted stack: " << report.prefaulted_stack_size
+              << " bytes, prefaulted heap: " << report.prefaulted_heap_size << " bytes, heap pinned: " << report.heap_pinned
+              << std::endl;
+    std::cout << "errors: deadline=" << report.deadline_error << " fallback=" << report.fallback_error
+              << " memory=" << report.memory_error << std::endl;
+}
+
+void test_realtime_profile()
+{
+    std::cout << "-- realtime profile --" << std::endl;
+
+    static constexpr auto period = std::chrono::duration<int, std::micro>(10000);
+
+    // 1 ms budget every 10 ms, SCHED_FIFO fallback if SCHED_DEADLINE is refused
+    tools::realtime_profile profile;
+    profile.runtime = std::chrono::microseconds(1000);
+    profile.fallback_policy = tools::realtime_policy::fifo;
+    profile.fallback_priority = 1;
+    profile.prefault_stack_size = 64U * 1024U;
+    profile.prefault_heap_size = 256U * 1024U;
+    profile.pin_heap = true; // the prefaulted heap is otherwise given back to the system when freed (process wide)
+
+    {
+        auto lambda = [](std::shared_ptr<my_periodic_task_context> context, const std::string& task_name) -> void
+        {
+            (void)task_name;
+            context->loop_counter += 1;
+        };
+
+        auto context = std::make_shared<my_periodic_task_context>();
+        my_periodic_task task(
+            lambda, context, "periodic rt", period, tools::periodic_overrun_policy::skip_missed, profile);
+
+        std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(200));
+
+        std::cout << "periodic task: ";
+        display_realtime_report(task.realtime_status());
+        std::cout << "nb of periodic loops = " << context->loop_counter.load() << std::endl;
+    }
+
+    {
+        auto context = std::make_shared<my_periodic_task_context>();
+        tools::worker_task<my_periodic_task_context> worker(context, "worker_rt");
+
+        // a worker has no period: SCHED_DEADLINE needs the full budget
+        profile.deadline = std::chrono::microseconds(period);
+        profile.period = std::chrono::microseconds(period);
+
+        // larger than any thread stack: clamped to the free stack of the worker minus a safety margin
+        profile.prefault_stack_size = std::size_t { 1U } << 30U;
+
+        std::cout << "worker task: ";
+        display_realtime_report(worker.set_realtime_profile(profile).get());
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
 class my_collector : public base_observer
 {
 public:
@@ -1552,6 +2058,140 @@ void test_periodic_publish_subscribe()
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
+struct frame_pipeline_context
+{
+    tools::frame_arena arena { 1024U }; // deliberately small: the first tick overflows, then the buffer grows
+    std::atomic<int> loop_counter = 0;
+    std::atomic<std::size_t> dispatched_bytes = 0U;
+};
+
+void test_periodic_frame_arena()
+{
+    std::cout << "-- periodic frame arena --" << std::endl;
+
+    auto pipeline = [](std::shared_ptr<frame_pipeline_context> context, const std::string& task_name) -> void
+    {
+        (void)task_name;
+
+        // everything allocated from the arena during the tick is released at the end of the scope
+        tools::frame_arena_scope frame(context->arena);
+        const int tick = ++context->loop_counter;
+
+        // event buffers (pmr containers propagate the arena to their strings)
+        std::pmr::vector<std::pmr::string> events(&context->arena);
+        for (int i = 0; i < 32; ++i)
+        {
+            auto& event = events.emplace_back("periodic frame event, tick ");
+            event.append(std::to_string(tick));
+        }
+
+        // dispatch vector (STL allocator adapter)
+        std::vector<std::size_t, tools::frame_arena_allocator<std::size_t>> lengths {
+            tools::frame_arena_allocator<std::size_t>(context->arena)
+        };
+        for (const auto& event : events)
+        {
+            lengths.push_back(event.size());
+        }
+
+        context->dispatched_bytes += std::accumulate(lengths.begin(), lengths.end(), std::size_t { 0U });
+    };
+
+    auto context = std::make_shared<frame_pipeline_context>();
+    {
+        tools::periodic_task<frame_pipeline_context> periodic_task(
+            pipeline, context, "frame pipeline", std::chrono::duration<int, std::micro>(10000));
+
+        std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(300));
+    }
+
+    std::cout << "ticks: " << context->loop_counter.load() << ", dispatched bytes: " << context->dispatched_bytes.load()
+              << std::endl;
+    std::cout << "arena capacity: " << context->arena.capacity()
+              << " bytes, high water mark: " << context->arena.high_water_mark()
+              << " bytes, overflow allocations: " << context->arena.overflow_allocations() << std::endl;
+
+    // an upstream resource refusing the grow-on-reset with any exception leaves the arena usable
+    class capped_resource : public std::pmr::memory_resource
+    {
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            if (bytes > 512U)
+            {
+                throw std::length_error("capped upstream resource");
+            }
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    capped_resource upstream;
+    tools::frame_arena capped_arena(256U, &upstream);
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        tools::frame_arena_scope scope(capped_arena);
+        for (int i = 0; i < 16; ++i)
+        {
+            (void)capped_arena.allocate(64U);
+        }
+    }
+    std::cout << "capped arena capacity: " << capped_arena.capacity()
+              << " bytes, overflow allocations: " << capped_arena.overflow_allocations() << std::endl;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+using my_periodic_scheduler = tools::periodic_scheduler<my_periodic_task_context>;
+
+void test_periodic_scheduler()
+{
+    std::cout << "-- periodic scheduler --" << std::endl;
+
+    auto lambda = [](std::shared_ptr<my_periodic_task_context> context, const std::string& task_name) -> void
+    {
+        (void)task_name;
+        context->loop_counter += 1;
+    };
+
+    auto context_10ms = std::make_shared<my_periodic_task_context>();
+    auto context_20ms = std::make_shared<my_periodic_task_context>();
+    auto context_40ms = std::make_shared<my_periodic_task_context>();
+
+    {
+        // 3 routines with harmonic periods multiplexed on a single thread
+        my_periodic_scheduler scheduler("sched_1", 1U);
+        scheduler.add(lambda, context_10ms, "routine 10 ms", std::chrono::duration<int, std::micro>(10000));
+        scheduler.add(lambda, context_20ms, "routine 20 ms", std::chrono::duration<int, std::micro>(20000));
+        const auto id_40ms
+            = scheduler.add(lambda, context_40ms, "routine 40 ms", std::chrono::duration<int, std::micro>(40000));
+
+        std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1000));
+
+        std::cout << "routines: " << scheduler.size() << " on " << scheduler.nb_threads() << " thread(s)"
+                  << std::endl;
+        std::cout << "wakeups: " << scheduler.wakeup_count() << std::endl;
+
+        scheduler.remove(id_40ms);
+        std::cout << "routines after remove: " << scheduler.size() << std::endl;
+    }
+
+    std::cout << "nb of 10 ms loops = " << context_10ms->loop_counter.load() << std::endl;
+    std::cout << "nb of 20 ms loops = " << context_20ms->loop_counter.load() << std::endl;
+    std::cout << "nb of 40 ms loops = " << context_40ms->loop_counter.load() << std::endl;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
 void test_queued_commands()
 {
     std::cout << "-- queued commands --" << std::endl;
@@ -1796,7 +2436,27 @@ void test_portable_concurrency_test_parity()
         check(any_result.futures[0].get() == 7, "when_any(vector) contains completed future");
     }
 
-    // packaged_task unwrap: future<future<T>> collapses to future<T> and invalid inner future becomes broken_promise.
+    // when_all vector: ready only once every input is, inputs already ready are accounted for.
+    {
+        auto p0 = portable_concurrency::make_promise<int>();
+        auto p1 = portable_concurrency::make_promise<int>();
+
+        std::vector<portable_concurrency::future<int>> futures;
+        futures.emplace_back(std::move(p0.second));
+        futures.emplace_back(portable_concurrency::make_ready_future(2));
+        futures.emplace_back(std::move(p1.second));
+
+        auto all_future = portable_concurrency::when_all(std::move(futures));
+        p1.first.set_value(3);
+        check(!all_future.is_ready(), "when_all(vector) not ready while an input is pending");
+
+        p0.first.set_value(1);
+        auto all_result = all_future.get();
+        check((all_result[0].get() == 1) && (all_result[1].get() == 2) && (all_result[2].get() == 3),
+            "when_all(vector) keeps input order");
+    }
+
+    // packaged_task unwrap: future<future<T>> collapses to future<T> and invalid inner future becomes broken_promise.
     {
         portable_concurrency::packaged_task<portable_concurrency::future<int>()> task_ok(
             []() { return portable_concurrency::make_ready_future(42); });
@@ -1914,6 +2574,585 @@ void test_portable_concurrency_test_parity()
     std::cout << "  summary: passed=" << passed << " failed=" << failed << std::endl;
 }
 
+void test_thread_pool_work_stealing()
+{
+    std::cout << "-- thread pool work stealing --" << std::endl;
+
+    constexpr int nb_roots = 64;
+    constexpr int nb_children = 256;
+
+    portable_concurrency::static_thread_pool pool(4U);
+    auto executor = pool.executor();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // roots are posted from outside (shared queue), children from inside a worker (local deques)
+    std::vector<portable_concurrency::future<int>> roots;
+    roots.reserve(nb_roots);
+    for (int root = 0; root < nb_roots; ++root)
+    {
+        roots.emplace_back(portable_concurrency::async(executor,
+            [executor]()
+            {
+                std::vector<portable_concurrency::future<int>> children;
+                children.reserve(nb_children);
+                for (int child = 0; child < nb_children; ++child)
+                {
+                    children.emplace_back(portable_concurrency::async(executor, [child]() { return child; }));
+                }
+
+                return portable_concurrency::when_all(std::move(children))
+                    .next(
+                        [](std::vector<portable_concurrency::future<int>> results)
+                        {
+                            int sum = 0;
+                            for (auto& result : results)
+                            {
+                                sum += result.get();
+                            }
+                            return sum;
+                        });
+            }));
+    }
+
+    long long total = 0;
+    for (auto& root : roots)
+    {
+        total += root.get();
+    }
+
+    const auto elapsed
+        = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    const long long expected = static_cast<long long>(nb_roots) * (nb_children * (nb_children - 1) / 2);
+
+    std::cout << "tasks: " << nb_roots * (nb_children + 1) << " in " << elapsed << " us, total " << total
+              << ((total == expected) ? " (ok)" : " (MISMATCH)") << std::endl;
+
+    pool.wait();
+}
+
+void test_thread_pool_fairness()
+{
+    std::cout << "-- thread pool fairness --" << std::endl;
+
+    constexpr int max_reposts = 1000000;
+
+    // a single worker re-posting to itself must still run injected and older local tasks
+    {
+        portable_concurrency::static_thread_pool pool(1U);
+        auto executor = pool.executor();
+
+        std::atomic<bool> injected_ran { false };
+        std::atomic<bool> older_ran { false };
+        std::atomic<bool> started { false };
+        std::atomic<int> reposts { 0 };
+        std::function<void()> repost;
+        repost = [&]()
+        {
+            started.store(true);
+            if ((!injected_ran.load() || !older_ran.load()) && reposts.fetch_add(1) < max_reposts)
+            {
+                post(executor, [&repost]() { repost(); });
+            }
+        };
+
+        post(executor,
+            [&]()
+            {
+                post(executor, [&older_ran]() { older_ran.store(true); });
+                repost();
+            });
+        while (!started.load())
+        {
+            std::this_thread::yield();
+        }
+        post(executor, [&injected_ran]() { injected_ran.store(true); });
+        pool.wait();
+
+        std::cout << "reposts before injected and older tasks ran: " << reposts.load()
+                  << ((injected_ran.load() && older_ran.load() && reposts.load() < max_reposts) ? " (ok)" : " (STARVED)")
+                  << std::endl;
+    }
+
+    // posting to a stopped pool drops the task and breaks its promise
+    {
+        portable_concurrency::static_thread_pool pool(1U);
+        auto executor = pool.executor();
+        pool.stop();
+        pool.wait();
+
+        auto result = portable_concurrency::async(executor, []() { return 42; });
+        bool broken = false;
+        try
+        {
+            result.get();
+        }
+        catch (const std::future_error& error)
+        {
+            broken = (error.code() == std::make_error_code(std::future_errc::broken_promise));
+        }
+        std::cout << "post after stop: " << (broken ? "broken promise (ok)" : "MISMATCH") << std::endl;
+
+        bool bulk_signalled = false;
+        bulk_execute(
+            executor, 10U, [](std::size_t) {},
+            [&bulk_signalled](std::exception_ptr error) { bulk_signalled = static_cast<bool>(error); });
+        std::cout << "bulk_execute after stop: " << (bulk_signalled ? "completion signalled (ok)" : "MISMATCH")
+                  << std::endl;
+    }
+}
+
+void test_thread_pool_bulk_submission()
+{
+    std::cout << "-- thread pool bulk submission --" << std::endl;
+
+    constexpr std::size_t nb_tasks = 100000U;
+
+    portable_concurrency::static_thread_pool pool(4U);
+    auto executor = pool.executor();
+
+    // one post per task
+    {
+        std::atomic<std::size_t> sum { 0U };
+        portable_concurrency::latch done(static_cast<std::ptrdiff_t>(nb_tasks));
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0U; i < nb_tasks; ++i)
+        {
+            post(executor,
+                [&sum, &done, i]()
+                {
+                    sum.fetch_add(i, std::memory_order_relaxed);
+                    done.count_down();
+                });
+        }
+        done.wait();
+        const auto elapsed
+            = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "post x" << nb_tasks << ": " << elapsed << " us, sum " << sum.load() << std::endl;
+    }
+
+    // whole batch under one lock
+    {
+        std::atomic<std::size_t> sum { 0U };
+        portable_concurrency::latch done(static_cast<std::ptrdiff_t>(nb_tasks));
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<portable_concurrency::unique_function<void()>> tasks;
+        tasks.reserve(nb_tasks);
+        for (std::size_t i = 0U; i < nb_tasks; ++i)
+        {
+            tasks.emplace_back(
+                [&sum, &done, i]()
+                {
+                    sum.fetch_add(i, std::memory_order_relaxed);
+                    done.count_down();
+                });
+        }
+        post_n(executor, tasks.data(), tasks.size());
+        done.wait();
+        const auto elapsed
+            = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "post_n(" << nb_tasks << "): " << elapsed << " us, sum " << sum.load() << std::endl;
+    }
+
+    // single queue entry sharing an index counter
+    {
+        std::atomic<std::size_t> sum { 0U };
+        auto completion = portable_concurrency::make_promise<void>();
+        auto finished = std::move(completion.second);
+
+        const auto start = std::chrono::steady_clock::now();
+        bulk_execute(
+            executor, nb_tasks, [&sum](std::size_t i) { sum.fetch_add(i, std::memory_order_relaxed); },
+            [promise = std::move(completion.first)](std::exception_ptr error) mutable
+            {
+                if (error)
+                {
+                    promise.set_exception(error);
+                }
+                else
+                {
+                    promise.set_value();
+                }
+            });
+        finished.get();
+        const auto elapsed
+            = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "bulk_execute(" << nb_tasks << "): " << elapsed << " us, sum " << sum.load()
+                  << ((sum.load() == nb_tasks * (nb_tasks - 1U) / 2U) ? " (ok)" : " (MISMATCH)") << std::endl;
+    }
+
+    // a throwing index is reported to completion once every index has run
+    {
+        std::atomic<std::size_t> calls { 0U };
+        auto completion = portable_concurrency::make_promise<void>();
+        auto finished = std::move(completion.second);
+
+        bulk_execute(
+            executor, 1000U,
+            [&calls](std::size_t i)
+            {
+                calls.fetch_add(1U, std::memory_order_relaxed);
+                if (i % 100U == 7U)
+                {
+                    throw std::runtime_error("bulk index failed");
+                }
+            },
+            [promise = std::move(completion.first)](std::exception_ptr error) mutable
+            {
+                if (error)
+                {
+                    promise.set_exception(error);
+                }
+                else
+                {
+                    promise.set_value();
+                }
+            });
+
+        bool reported = false;
+        try
+        {
+            finished.get();
+        }
+        catch (const std::runtime_error&)
+        {
+            reported = true;
+        }
+        std::cout << "bulk_execute with throwing indices: " << calls.load() << " calls"
+                  << ((reported && calls.load() == 1000U) ? ", error reported (ok)" : " (MISMATCH)") << std::endl;
+    }
+
+    // a bulk job still queued when its pool stops is completed with broken_promise
+    {
+        std::atomic<bool> started { false };
+        std::atomic<bool> release { false };
+        std::atomic<std::size_t> calls { 0U };
+        bool broken = false;
+        {
+            portable_concurrency::static_thread_pool busy_pool(1U);
+            auto busy_executor = busy_pool.executor();
+            post(busy_executor,
+                [&started, &release]()
+                {
+                    started.store(true);
+                    while (!release.load())
+                    {
+                        std::this_thread::yield();
+                    }
+                });
+            while (!started.load())
+            {
+                std::this_thread::yield();
+            }
+
+            bulk_execute(
+                busy_executor, 100U, [&calls](std::size_t) { calls.fetch_add(1U, std::memory_order_relaxed); },
+                [&broken](std::exception_ptr error)
+                {
+                    try
+                    {
+                        if (error)
+                        {
+                            std::rethrow_exception(error);
+                        }
+                    }
+                    catch (const std::future_error& future_error)
+                    {
+                        broken = (future_error.code() == std::make_error_code(std::future_errc::broken_promise));
+                    }
+                });
+            busy_pool.stop();
+            release.store(true);
+            busy_pool.wait();
+        }
+        std::cout << "bulk_execute queued on a stopped pool: " << calls.load() << " calls"
+                  << ((broken && calls.load() == 0U) ? ", completion signalled (ok)" : " (MISMATCH)") << std::endl;
+    }
+
+    pool.wait();
+}
+
+void test_future_chain_throughput()
+{
+    std::cout << "-- future chain throughput --" << std::endl;
+
+    constexpr int nb_chains = 1000;
+    constexpr int nb_stages = 100;
+
+    portable_concurrency::static_thread_pool pool(2U);
+    auto executor = pool.executor();
+
+    // every stage allocates a continuation state, recycled by the thread local state pool
+    const auto start = std::chrono::steady_clock::now();
+
+    long long total = 0;
+    for (int chain = 0; chain < nb_chains; ++chain)
+    {
+        auto value = portable_concurrency::async(executor, [chain]() { return chain; });
+        for (int stage = 0; stage < nb_stages; ++stage)
+        {
+            value = value.next([](int previous) { return previous + 1; });
+        }
+        total += value.get();
+    }
+
+    const auto elapsed
+        = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    const long long expected = static_cast<long long>(nb_chains) * (nb_chains - 1) / 2 + nb_chains * nb_stages;
+
+    std::cout << "stages: " << nb_chains * nb_stages << " in " << elapsed << " us, total " << total
+              << ((total == expected) ? " (ok)" : " (MISMATCH)") << std::endl;
+
+    pool.wait();
+}
+
+void test_future_wait_latency()
+{
+    std::cout << "-- future wait latency --" << std::endl;
+
+    constexpr int nb_ready = 100000;
+    constexpr int nb_round_trips = 10000;
+
+    // already ready: a single atomic load, no continuation pushed
+    {
+        const auto start = std::chrono::steady_clock::now();
+        long long total = 0;
+        for (int i = 0; i < nb_ready; ++i)
+        {
+            auto value = portable_concurrency::make_ready_future(i);
+            value.wait();
+            total += value.get();
+        }
+        const auto elapsed
+            = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "ready get x" << nb_ready << ": " << elapsed << " us (total " << total << ")" << std::endl;
+    }
+
+    // completed on another thread: spin then park on a wait word
+    {
+        portable_concurrency::static_thread_pool pool(1U);
+        auto executor = pool.executor();
+
+        const auto start = std::chrono::steady_clock::now();
+        long long total = 0;
+        for (int i = 0; i < nb_round_trips; ++i)
+        {
+            total += portable_concurrency::async(executor, [i]() { return i; }).get();
+        }
+        const auto elapsed
+            = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "async round trip x" << nb_round_trips << ": " << elapsed << " us (total " << total << ")"
+                  << std::endl;
+
+        pool.wait();
+    }
+}
+
+void test_future_fused_continuations()
+{
+    std::cout << "-- future fused continuations --" << std::endl;
+
+    constexpr int nb_chains = 1000;
+
+    portable_concurrency::static_thread_pool pool(2U);
+    auto executor = pool.executor();
+
+    auto measure = [&executor](auto&& attach_stages)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        long long total = 0;
+        for (int chain = 0; chain < nb_chains; ++chain)
+        {
+            total += attach_stages(portable_concurrency::async(executor, [chain]() { return chain; })).get();
+        }
+        const auto elapsed
+            = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(total, elapsed);
+    };
+
+    auto add_one = [](int value) { return value + 1; };
+    auto twice = [](int value) { return value * 2; };
+    auto minus_three = [](int value) { return value - 3; };
+
+    // one continuation state and one post per stage
+    const auto [chained_total, chained_elapsed] = measure(
+        [&](portable_concurrency::future<int> value)
+        { return value.next(executor, add_one).next(executor, twice).next(executor, minus_three); });
+
+    // the three stages collapsed into a single continuation
+    const auto [fused_total, fused_elapsed]
+        = measure([&](portable_concurrency::future<int> value)
+            { return value.next(executor, portable_concurrency::fuse(add_one, twice, minus_three)); });
+
+    std::cout << "chained stages: " << chained_elapsed << " us, fused stages: " << fused_elapsed << " us"
+              << ((chained_total == fused_total) ? " (same results)" : " (MISMATCH)") << std::endl;
+
+    // a continuation scheduled on the pool from a pool thread runs in place
+    const bool pool_inline = portable_concurrency::async(executor,
+        [executor]()
+        {
+            auto ran = std::make_shared<std::atomic<bool>>(false);
+            portable_concurrency::make_ready_future().next(executor, [ran]() { ran->store(true); }).detach();
+            return ran->load();
+        })
+                                 .get();
+    std::cout << "pool continuation inline: " << (pool_inline ? "yes" : "no") << std::endl;
+
+    pool.wait();
+
+    // same on a worker task executor
+    auto context = std::make_shared<my_worker_task_context>();
+    auto task = std::make_unique<my_worker_task>(context, "worker_inline");
+    auto worker_executor = task->as_executor();
+
+    const bool worker_inline = task->delegate_async(
+                                       [worker_executor](const std::shared_ptr<my_worker_task_context>&,
+                                           const std::string&)
+                                       {
+                                           auto ran = std::make_shared<std::atomic<bool>>(false);
+                                           portable_concurrency::make_ready_future()
+                                               .next(worker_executor, [ran]() { ran->store(true); })
+                                               .detach();
+                                           return ran->load();
+                                       })
+                                   .get();
+    std::cout << "worker continuation inline: " << (worker_inline ? "yes" : "no") << std::endl;
+}
+
+void test_cooperative_cancellation()
+{
+    std::cout << "-- cooperative cancellation --" << std::endl;
+
+    using namespace std::chrono_literals;
+
+    // polls the token between slices of work, returns the number of slices done
+    auto long_job = [](portable_concurrency::stop_token token, int slices)
+    {
+        int done = 0;
+        for (; done < slices && !token.stop_requested(); ++done)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+        return done;
+    };
+
+    auto outcome = [](auto& job)
+    {
+        try
+        {
+            return std::to_string(job.get()) + " slices";
+        }
+        catch (const portable_concurrency::operation_cancelled&)
+        {
+            return std::string("skipped");
+        }
+        catch (const std::exception& ex)
+        {
+            return std::string(ex.what());
+        }
+    };
+
+    portable_concurrency::static_thread_pool pool(2U);
+    auto executor = pool.executor();
+
+    // when_any: the first ready job stops the others, the queued ones never start
+    {
+        portable_concurrency::stop_source source;
+        auto token = source.get_token();
+
+        std::vector<portable_concurrency::future<int>> jobs;
+        jobs.push_back(portable_concurrency::async(executor, token, long_job, token, 5));
+        for (int i = 0; i < 4; ++i)
+        {
+            jobs.push_back(portable_concurrency::async(executor, token, long_job, token, 200));
+        }
+
+        auto first = portable_concurrency::when_any(source, std::move(jobs)).get();
+        std::cout << "when_any winner #" << first.index << ", stop requested: " << std::boolalpha
+                  << source.stop_requested() << std::endl;
+        for (std::size_t i = 0; i < first.futures.size(); ++i)
+        {
+            std::cout << "  job #" << i << ": " << outcome(first.futures[i]) << std::endl;
+        }
+    }
+
+    // when_all: a failing job stops its siblings instead of letting them run to completion
+    {
+        portable_concurrency::stop_source source;
+        auto token = source.get_token();
+
+        auto failing = portable_concurrency::async(executor,
+            []() -> int
+            {
+                std::this_thread::sleep_for(2ms);
+                throw std::runtime_error("job failed");
+            });
+        auto sibling = portable_concurrency::async(executor, token, long_job, token, 200);
+        auto queued = portable_concurrency::async(executor, token, long_job, token, 200);
+
+        auto all = portable_concurrency::when_all(source, std::move(failing), std::move(sibling), std::move(queued))
+                       .get();
+        std::cout << "when_all failing: " << outcome(std::get<0>(all)) << ", sibling: " << outcome(std::get<1>(all))
+                  << ", queued: " << outcome(std::get<2>(all)) << std::endl;
+    }
+
+    // continuation skipped once the stop was requested
+    {
+        portable_concurrency::stop_source source;
+        auto token = source.get_token();
+
+        auto [input, input_future] = portable_concurrency::make_promise<int>();
+        auto stage = input_future.next(
+            executor, portable_concurrency::stoppable(token, [](int value) { return value * 2; }));
+        source.request_stop();
+        input.set_value(21);
+        std::cout << "stoppable continuation: " << outcome(stage) << std::endl;
+    }
+
+    pool.wait();
+
+    // worker task: a client timeout drops the jobs still waiting in the queue
+    {
+        auto context = std::make_shared<my_worker_task_context>();
+        auto task = std::make_unique<my_worker_task>(context, "worker_cancel");
+
+        portable_concurrency::stop_source source;
+        auto token = source.get_token();
+
+        std::vector<portable_concurrency::future<int>> jobs;
+        for (int i = 0; i < 5; ++i)
+        {
+            jobs.push_back(task->delegate_async(token,
+                [token](const std::shared_ptr<my_worker_task_context>& ctx, const std::string&, int slices)
+                {
+                    ctx->loop_counter++;
+                    int done = 0;
+                    for (; done < slices && !token.stop_requested(); ++done)
+                    {
+                        std::this_thread::sleep_for(1ms);
+                    }
+                    return done;
+                },
+                100));
+        }
+
+        std::this_thread::sleep_for(10ms);
+        source.request_stop();
+
+        int skipped = 0;
+        for (auto& job : jobs)
+        {
+            skipped += (outcome(job) == "skipped") ? 1 : 0;
+        }
+        std::cout << "worker jobs started: " << context->loop_counter.load() << ", skipped: " << skipped << std::endl;
+    }
+}
+
 #if defined(PC_HAS_COROUTINES)
 portable_concurrency::future<int> worker_task_coro_job(
     my_worker_task& task, const std::shared_ptr<my_worker_task_context>& context, int value)
@@ -1991,6 +3230,74 @@ void test_worker_tasks_mixed_execution()
     std::cout << "mixed execution result = " << mixed_result << std::endl;
     std::cout << "mixed execution jobs executed = " << context->loop_counter.load() << std::endl;
 }
+
+#if defined(PC_HAS_SYMMETRIC_TRANSFER)
+portable_concurrency::task<int> task_chain_link(int depth)
+{
+    if (depth == 0)
+    {
+        co_return 0;
+    }
+
+    // awaiting a lazy task: no shared state, the child resumes us by symmetric transfer
+    co_return 1 + co_await task_chain_link(depth - 1);
+}
+
+portable_concurrency::future<int> future_chain_link(int depth)
+{
+    if (depth == 0)
+    {
+        co_return 0;
+    }
+
+    co_return 1 + co_await future_chain_link(depth - 1);
+}
+
+portable_concurrency::task<int> worker_task_lazy_job(
+    my_worker_task& task, std::shared_ptr<my_worker_task_context> context)
+{
+    // hop to the worker thread, then run a task chain there
+    co_await task.schedule();
+
+    context->loop_counter++;
+    co_return co_await task_chain_link(100);
+}
+
+void test_coroutine_task_chain()
+{
+    std::cout << "-- coroutine task chain --" << std::endl;
+
+    constexpr int depth = 1000;
+    constexpr int nb_chains = 100;
+
+    auto measure = [](auto&& make_chain)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        long long total = 0;
+        for (int i = 0; i < nb_chains; ++i)
+        {
+            portable_concurrency::future<int> result = make_chain(depth);
+            total += result.get();
+        }
+        const auto elapsed
+            = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(total, elapsed);
+    };
+
+    const auto [task_total, task_elapsed] = measure([](int d) { return task_chain_link(d); });
+    const auto [future_total, future_elapsed] = measure([](int d) { return future_chain_link(d); });
+
+    std::cout << "task<int> chains: " << task_elapsed << " us (total " << task_total << ")" << std::endl;
+    std::cout << "future<int> chains: " << future_elapsed << " us (total " << future_total << ")" << std::endl;
+
+    auto context = std::make_shared<my_worker_task_context>();
+    auto task = std::make_unique<my_worker_task>(context, "worker_lazy_task");
+
+    portable_concurrency::future<int> on_worker = worker_task_lazy_job(*task, context);
+    std::cout << "task on worker result = " << on_worker.get() << ", jobs executed = " << context->loop_counter.load()
+              << std::endl;
+}
+#endif
 #endif
 
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -2087,10 +3394,93 @@ namespace
     }
 }
 
+namespace
+{
+    struct alignas(64) cache_line_event
+    {
+        std::array<std::uint8_t, 48> payload;
+    };
+}
+
+void test_aligned_allocations()
+{
+    std::cout << "-- aligned allocations --\n";
+
+    std::vector<std::unique_ptr<cache_line_event>> events;
+    std::size_t misaligned = 0U;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        events.emplace_back(std::make_unique<cache_line_event>());
+        if ((reinterpret_cast<std::uintptr_t>(events.back().get()) % alignof(cache_line_event)) != 0U)
+        {
+            ++misaligned;
+        }
+    }
+
+    auto* array_events = new cache_line_event[16];
+    if ((reinterpret_cast<std::uintptr_t>(array_events) % alignof(cache_line_event)) != 0U)
+    {
+        ++misaligned;
+    }
+    delete[] array_events;
+
+    // a heap block recycled into a size class (the fallback once its slabs are exhausted) is only malloc
+    // aligned: it must not serve an over-aligned request of that class
+    constexpr std::size_t line_size = alignof(cache_line_event);
+    std::vector<void*> heap_blocks;
+    void* heap_block = nullptr;
+    while (nullptr == heap_block)
+    {
+        void* candidate = std::malloc(line_size);
+        if (nullptr == candidate)
+        {
+            break;
+        }
+        if ((reinterpret_cast<std::uintptr_t>(candidate) % line_size) != 0U)
+        {
+            heap_block = candidate;
+        }
+        else
+        {
+            heap_blocks.push_back(candidate);
+        }
+    }
+    for (void* block : heap_blocks)
+    {
+        std::free(block);
+    }
+    if (nullptr != heap_block)
+    {
+        tools::mem_pool_deallocate(heap_block, line_size);
+        void* line = tools::mem_pool_allocate(line_size, line_size);
+        if ((reinterpret_cast<std::uintptr_t>(line) % line_size) != 0U)
+        {
+            ++misaligned;
+        }
+        tools::mem_pool_deallocate(line, line_size, line_size);
+    }
+
+    std::cout << "misaligned blocks: " << misaligned << std::endl;
+}
+
 void test_allocator_stress()
 {
     std::cout << "-- allocator stress --\n";
 
+#if defined(USE_MEM_POOL_ALLOCATOR)
+    // periodic dump of the mem pool statistics during the stress
+    auto dump_stats = [](std::shared_ptr<my_periodic_task_context> context, const std::string& task_name) -> void
+    {
+        (void)context;
+        (void)task_name;
+        tools::dump_mem_pool_stats(std::cout, tools::mem_pool_stats());
+    };
+    auto stats_context = std::make_shared<my_periodic_task_context>();
+    auto stats_task = std::make_unique<my_periodic_task>(
+        dump_stats, stats_context, "mem pool stats", std::chrono::duration<int, std::micro>(500000));
+#endif
+
     const auto start = std::chrono::high_resolution_clock::now();
     std::thread thr1(alloc_dealloc_worker, 1);
     std::thread thr2(alloc_dealloc_worker, 2);
@@ -2099,14 +3489,13 @@ void test_allocator_stress()
     const auto end = std::chrono::high_resolution_clock::now();
     const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
     std::cout << "allocation/deallocation total time: " << millis << " ms\n";
-}
-//--------------------------------------------------------------------------------------------------------------------------------
 
 #if defined(USE_MEM_POOL_ALLOCATOR)
-// https://www.rastergrid.com/blog/sw-eng/2021/03/custom-memory-allocators/
-extern void init_mem_pool_allocator();
-extern void destroy_mem_pool_allocator();
+    stats_task.reset();
+    tools::dump_mem_pool_stats(std::cout, tools::mem_pool_stats());
 #endif
+}
+//--------------------------------------------------------------------------------------------------------------------------------
 
 int main(int argc, char* argv[])
 {
@@ -2134,10 +3523,21 @@ int main(int argc, char* argv[])
     test_sync_time_list();
     test_sync_time_list_unit_style();
     test_histogram();
+    test_histogram_non_arithmetic();
+    test_histogram_batch_kernels();
+    test_hdr_histogram();
+    test_concurrent_histogram();
+    test_windowed_histogram();
+    test_heavy_hitters();
 
     test_publish_subscribe();
+    test_mem_pool_resource();
+    test_mem_pool_trimming();
     test_periodic_task();
     test_periodic_publish_subscribe();
+    test_periodic_frame_arena();
+    test_periodic_scheduler();
+    test_realtime_profile();
 
     test_queued_commands();
     test_ring_buffer_commands();
@@ -2145,11 +3545,22 @@ int main(int argc, char* argv[])
     test_worker_tasks_async();
     test_worker_tasks_async_fanout();
     test_portable_concurrency_test_parity();
+    test_thread_pool_work_stealing();
+    test_thread_pool_fairness();
+    test_thread_pool_bulk_submission();
+    test_future_chain_throughput();
+    test_future_wait_latency();
+    test_future_fused_continuations();
+    test_cooperative_cancellation();
 #if defined(PC_HAS_COROUTINES)
     test_worker_tasks_coroutine_schedule();
     test_worker_tasks_mixed_execution();
+#if defined(PC_HAS_SYMMETRIC_TRANSFER)
+    test_coroutine_task_chain();
+#endif
 #endif
 
+    test_aligned_allocations();
     test_allocator_stress();
 
 #if defined(USE_MEM_POOL_ALLOCATOR)
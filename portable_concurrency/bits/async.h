@@ -8,6 +8,7 @@
 #include "invoke.h"
 #include "packaged_task.h"
 #include "shared_state.h"
+#include "stop_token.h"
 #include "then.hpp"
 
 #include <portable_concurrency/bits/config.h>
@@ -73,6 +74,31 @@ PC_NODISCARD auto async(E &&exec, F &&func, A &&...a) -> std::enable_if_t<
   return f;
 }
 
+/**
+ * @ingroup future_hdr
+ * @brief Cancellable `async`
+ *
+ * Same as `async(exec, func, a...)` except that `func` is not invoked if a stop
+ * was requested through `token` before the executor dequeued the task. The
+ * returned future then holds an @ref operation_cancelled exception. A running
+ * `func` may poll the same token to return early.
+ */
+#if defined(DOXYGEN)
+template <typename E, typename F, typename... A>
+future<std::result_of_t<F(A...)>> async(E &&exec, stop_token token, F &&func,
+                                        A &&...a) {
+#else
+template <typename E, typename F, typename... A>
+PC_NODISCARD auto async(E &&exec, stop_token token, F &&func, A &&...a)
+    -> std::enable_if_t<
+        is_executor<std::decay_t<E>>::value,
+        detail::add_future_t<detail::invoke_result_t<F, A...>>> {
+#endif
+  return async(std::forward<E>(exec),
+               stoppable(std::move(token), std::forward<F>(func)),
+               std::forward<A>(a)...);
+}
+
 /**
  * @page unwrap Implicit unwrapping
  *
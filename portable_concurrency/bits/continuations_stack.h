@@ -14,6 +14,8 @@ extern template class once_consumable_stack<continuation>;
 class continuations_stack {
 public:
   void push(continuation &&cnt);
+  /// push a caller provided node, run it in place if already executed
+  void push(forward_list<continuation> node);
   template <typename Alloc> void push(continuation &&cnt, const Alloc &alloc) {
     if (!stack_.push(cnt, alloc))
       cnt();
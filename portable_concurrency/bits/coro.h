@@ -7,12 +7,17 @@ namespace portable_concurrency {
 inline namespace cxx14_v1 {
 namespace detail {
 using suspend_never = std::suspend_never;
+using suspend_always = std::suspend_always;
 template <typename Promise = void>
 using coroutine_handle = std::coroutine_handle<Promise>;
+inline coroutine_handle<> noop_coroutine() noexcept {
+  return std::noop_coroutine();
+}
 } // namespace detail
 } // namespace cxx14_v1
 } // namespace portable_concurrency
 #define PC_HAS_COROUTINES
+#define PC_HAS_SYMMETRIC_TRANSFER
 #endif
 #elif defined(__cpp_coroutines)
 #include <experimental/coroutine>
@@ -20,6 +25,7 @@ namespace portable_concurrency {
 inline namespace cxx14_v1 {
 namespace detail {
 using suspend_never = std::experimental::suspend_never;
+using suspend_always = std::experimental::suspend_always;
 template <typename Promise = void>
 using coroutine_handle = std::experimental::coroutine_handle<Promise>;
 #define PC_HAS_COROUTINES
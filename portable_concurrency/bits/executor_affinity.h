@@ -0,0 +1,56 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "voidify.h"
+
+namespace portable_concurrency {
+inline namespace cxx14_v1 {
+namespace detail {
+
+// Executors may provide an ADL discoverable
+// `bool running_in_this_thread(const Executor &)` telling whether the calling
+// thread already runs tasks of that executor. Continuations scheduled on such
+// an executor from one of its own threads are then invoked in place instead of
+// being posted again.
+template <typename E, typename = void>
+struct has_thread_affinity : std::false_type {};
+
+template <typename E>
+struct has_thread_affinity<
+    E, typename voidify<decltype(running_in_this_thread(
+           std::declval<const E &>()))>::type> : std::true_type {};
+
+// bounds the nesting of in place continuations on a thread
+constexpr unsigned max_inline_continuation_depth = 16;
+unsigned &inline_continuation_depth() noexcept;
+
+template <typename E, typename Task>
+void post_or_run(E &exec, Task &&task, std::false_type) {
+  post(exec, std::forward<Task>(task));
+}
+
+template <typename E, typename Task>
+void post_or_run(E &exec, Task &&task, std::true_type) {
+  auto &depth = inline_continuation_depth();
+  if (depth >= max_inline_continuation_depth ||
+      !running_in_this_thread(static_cast<const E &>(exec))) {
+    post(exec, std::forward<Task>(task));
+    return;
+  }
+
+  struct depth_guard {
+    unsigned &depth;
+    ~depth_guard() { --depth; }
+  } guard{++depth};
+  std::forward<Task>(task)();
+}
+
+template <typename E, typename Task> void post_or_run(E &exec, Task &&task) {
+  post_or_run(exec, std::forward<Task>(task), has_thread_affinity<E>{});
+}
+
+} // namespace detail
+} // namespace cxx14_v1
+} // namespace portable_concurrency
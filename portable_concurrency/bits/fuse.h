@@ -0,0 +1,87 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "concurrency_type_traits.h"
+#include "invoke.h"
+
+namespace portable_concurrency {
+inline namespace cxx14_v1 {
+namespace detail {
+
+template <typename... F> class fused;
+
+// result of feeding the result R of one stage to the next stages
+template <typename Next, typename R>
+struct fused_step_result : invoke_result<Next, R> {};
+template <typename Next>
+struct fused_step_result<Next, void> : invoke_result<Next> {};
+
+template <typename F> class fused<F> {
+public:
+  template <typename U>
+  explicit fused(U &&func) : func_(std::forward<U>(func)) {}
+
+  template <typename... A>
+  invoke_result_t<F, A...> operator()(A &&...args) && {
+    return detail::invoke(std::move(func_), std::forward<A>(args)...);
+  }
+
+private:
+  F func_;
+};
+
+template <typename F, typename... G> class fused<F, G...> {
+public:
+  template <typename U, typename... V>
+  explicit fused(U &&func, V &&...next)
+      : func_(std::forward<U>(func)), next_(std::forward<V>(next)...) {}
+
+  template <typename... A, typename R = invoke_result_t<F, A...>>
+  typename fused_step_result<fused<G...>, R>::type operator()(A &&...args) && {
+    return call(std::is_void<R>{}, std::forward<A>(args)...);
+  }
+
+private:
+  template <typename... A> decltype(auto) call(std::false_type, A &&...args) {
+    return std::move(next_)(
+        detail::invoke(std::move(func_), std::forward<A>(args)...));
+  }
+
+  template <typename... A> decltype(auto) call(std::true_type, A &&...args) {
+    detail::invoke(std::move(func_), std::forward<A>(args)...);
+    return std::move(next_)();
+  }
+
+private:
+  F func_;
+  fused<G...> next_;
+};
+
+} // namespace detail
+
+/**
+ * @headerfile portable_concurrency/future
+ * @ingroup future_hdr
+ * @brief Composes several continuation stages into a single callable
+ *
+ * `fuse(f, g, h)` returns a function object which passes its arguments to `f`,
+ * the result of `f` to `g` and the result of `g` to `h`. A stage returning
+ * `void` makes the next stage be invoked without arguments. Attaching the
+ * result with a single `next` or `then` call:
+ * ```
+ * auto res = fut.next(exec, pc::fuse(parse, validate, store));
+ * ```
+ * allocates one continuation state and schedules one task on `exec` instead of
+ * one per stage as with `fut.next(exec, parse).next(exec, validate)...`.
+ * The resulting function object is invoked at most once.
+ */
+template <typename... F>
+detail::fused<std::decay_t<F>...> fuse(F &&...stages) {
+  static_assert(sizeof...(F) > 0, "fuse requires at least one stage");
+  return detail::fused<std::decay_t<F>...>{std::forward<F>(stages)...};
+}
+
+} // namespace cxx14_v1
+} // namespace portable_concurrency
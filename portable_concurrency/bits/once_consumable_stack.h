@@ -100,6 +100,15 @@ public:
     return false;
   }
 
+  /**
+   * Push a preallocated node. On success the stack takes ownership of the node
+   * and @a node becomes empty, otherwise @a node is left untouched and false is
+   * returned.
+   *
+   * @note Can be called from multiple threads.
+   */
+  bool push(forward_list<T> &node) noexcept;
+
   /**
    * Checks if the stack is @em consumed.
    *
@@ -123,8 +132,6 @@ private:
   // compariaions but must never be dereferenced.
   forward_list_node<T> *consumed_marker() const noexcept;
 
-  bool push(forward_list<T> &node) noexcept;
-
 private:
   std::atomic<forward_list_node<T> *> head_{nullptr};
 };
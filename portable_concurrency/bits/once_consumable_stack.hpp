@@ -5,6 +5,7 @@
 #include <utility>
 
 #include "once_consumable_stack.h"
+#include "state_allocator.h"
 
 namespace portable_concurrency {
 inline namespace cxx14_v1 {
@@ -69,7 +70,7 @@ template <typename T> once_consumable_stack<T>::~once_consumable_stack() {
 }
 
 template <typename T> bool once_consumable_stack<T>::push(T &val) {
-  return push(val, std::allocator<T>{});
+  return push(val, state_allocator<T>{});
 }
 
 template <typename T>
@@ -66,7 +66,9 @@ public:
   template <typename F>
   explicit packaged_task(F &&f)
       : state_{detail::in_place_index_t<1>{},
-               std::make_shared<detail::task_state<F, result_type, A...>>(
+               std::allocate_shared<detail::task_state<F, result_type, A...>>(
+                   detail::state_allocator<
+                       detail::task_state<F, result_type, A...>>{},
                    std::forward<F>(f))} {
     static_assert(
         std::is_convertible<detail::invoke_result_t<F, A...>, R>::value,
@@ -1,8 +1,25 @@
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <future>
-
-#include "closable_queue.hpp"
+#include <new>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PC_WAIT_WITH_FUTEX
+#elif !defined(__cpp_lib_atomic_wait)
+#define PC_WAIT_WITH_LOCK
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#include "executor_affinity.h"
 #include "future.hpp"
 #include "future_state.h"
 #include "latch.h"
@@ -12,10 +29,12 @@
 #include "shared_future.hpp"
 #include "shared_state.h"
 #include "small_unique_function.hpp"
+#include "state_allocator.h"
 #include "thread_pool.h"
 #include "unique_function.hpp"
 #include "when_all.h"
 #include "when_any.h"
+#include "work_stealing_scheduler.h"
 
 namespace portable_concurrency {
 inline namespace cxx14_v1 {
@@ -32,6 +51,11 @@ void continuations_stack::push(continuation &&cnt) {
     cnt();
 }
 
+void continuations_stack::push(forward_list<continuation> node) {
+  if (!stack_.push(node))
+    node->val();
+}
+
 void continuations_stack::execute() {
   auto continuations = stack_.consume();
   for (auto &cnt : continuations)
@@ -40,21 +64,204 @@ void continuations_stack::execute() {
 
 bool continuations_stack::executed() const { return stack_.is_consumed(); }
 
+namespace {
+
+constexpr int wait_spin_iterations = 128;
+
+inline void cpu_relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_pause();
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+// One shot wait word living on the stack of the waiting thread. With a futex
+// the notifier only hands the word address to the kernel after the store, which
+// is harmless even if the waiter already returned. Other back ends then store
+// `released` and the waiter only returns (destroying the word) once it has
+// observed it, so the notifier never touches a dead object.
+class wait_word {
+public:
+  static constexpr std::uint32_t pending = 0;
+  static constexpr std::uint32_t notified = 1;
+  static constexpr std::uint32_t released = 2;
+
+  void notify() noexcept {
+#if defined(PC_WAIT_WITH_FUTEX)
+    value_.store(notified, std::memory_order_release);
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&value_),
+              FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#elif defined(PC_WAIT_WITH_LOCK)
+    {
+      std::lock_guard<std::mutex> guard{mutex_};
+      value_.store(notified, std::memory_order_release);
+    }
+    cv_.notify_one();
+    value_.store(released, std::memory_order_release);
+#else
+    value_.store(notified, std::memory_order_release);
+    value_.notify_one();
+    value_.store(released, std::memory_order_release);
+#endif
+  }
+
+  void wait() noexcept {
+#if defined(PC_WAIT_WITH_FUTEX)
+    while (value_.load(std::memory_order_acquire) == pending)
+      ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&value_),
+                FUTEX_WAIT_PRIVATE, pending, nullptr, nullptr, 0);
+#else
+#if defined(PC_WAIT_WITH_LOCK)
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      cv_.wait(lock, [this] {
+        return value_.load(std::memory_order_acquire) != pending;
+      });
+    }
+#else
+    value_.wait(pending, std::memory_order_acquire);
+#endif
+    while (value_.load(std::memory_order_acquire) != released)
+      std::this_thread::yield();
+#endif
+  }
+
+private:
+#if defined(PC_WAIT_WITH_FUTEX)
+  static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+                "futex word must be a plain 32 bits integer");
+#endif
+  std::atomic<std::uint32_t> value_{pending};
+#if defined(PC_WAIT_WITH_LOCK)
+  std::mutex mutex_;
+  std::condition_variable cv_;
+#endif
+};
+
+} // namespace
+
+// Ready states cost a single atomic load, states becoming ready shortly are
+// caught by a short spin (skipped on single core machines where it would only
+// delay the notifier), only then the thread parks on a wait word.
 void wait(future_state_base &state) {
-  std::mutex mtx;
-  std::condition_variable cv;
-  bool ready = false;
-  state.push([&] {
-    std::lock_guard<std::mutex> guard{mtx};
-    ready = true;
-    cv.notify_one();
-  });
+  static const int spin_iterations =
+      std::thread::hardware_concurrency() > 1 ? wait_spin_iterations : 1;
+  auto &continuations = state.continuations();
+  for (int i = 0; i < spin_iterations; ++i) {
+    if (continuations.executed())
+      return;
+    cpu_relax();
+  }
 
-  std::unique_lock<std::mutex> lk{mtx};
-  cv.wait(lk, [&] { return ready; });
+  wait_word word;
+  state.push([&word] { word.notify(); });
+  word.wait();
 }
 
-template class closable_queue<unique_function<void()>>;
+unsigned &inline_continuation_depth() noexcept {
+  thread_local unsigned depth = 0;
+  return depth;
+}
+
+namespace {
+
+constexpr std::size_t state_block_granularity = 16;
+constexpr std::size_t state_block_classes = 32; // blocks up to 512 bytes
+constexpr std::size_t max_cached_state_blocks = 64; // per class and thread
+
+struct free_state_block {
+  free_state_block *next;
+};
+
+class state_block_cache {
+public:
+  state_block_cache() = default;
+  state_block_cache(const state_block_cache &) = delete;
+  state_block_cache &operator=(const state_block_cache &) = delete;
+
+  ~state_block_cache() {
+    for (auto *head : heads_) {
+      while (head) {
+        auto *next = head->next;
+        ::operator delete(head);
+        head = next;
+      }
+    }
+    destroyed() = true;
+  }
+
+  void *pop(std::size_t size_class) noexcept {
+    auto *block = heads_[size_class];
+    if (!block)
+      return nullptr;
+    heads_[size_class] = block->next;
+    --lengths_[size_class];
+    return block;
+  }
+
+  bool push(std::size_t size_class, void *ptr) noexcept {
+    if (lengths_[size_class] == max_cached_state_blocks)
+      return false;
+    heads_[size_class] = new (ptr) free_state_block{heads_[size_class]};
+    ++lengths_[size_class];
+    return true;
+  }
+
+  // blocks released by destructors of other thread locals after this cache is
+  // gone go straight back to the heap
+  static bool &destroyed() noexcept {
+    thread_local bool value = false;
+    return value;
+  }
+
+  static state_block_cache *instance() noexcept {
+    if (destroyed())
+      return nullptr;
+    thread_local state_block_cache cache;
+    return &cache;
+  }
+
+private:
+  free_state_block *heads_[state_block_classes] = {};
+  std::size_t lengths_[state_block_classes] = {};
+};
+
+} // namespace
+
+void *allocate_state_block(std::size_t size) {
+#if !defined(PC_DISABLE_STATE_POOL)
+  const std::size_t size_class =
+      (size + state_block_granularity - 1) / state_block_granularity - 1;
+  if (size != 0 && size_class < state_block_classes) {
+    if (auto *cache = state_block_cache::instance()) {
+      if (void *block = cache->pop(size_class))
+        return block;
+    }
+    return ::operator new((size_class + 1) * state_block_granularity);
+  }
+#endif
+  return ::operator new(size);
+}
+
+void deallocate_state_block(void *ptr, std::size_t size) noexcept {
+#if !defined(PC_DISABLE_STATE_POOL)
+  const std::size_t size_class =
+      (size + state_block_granularity - 1) / state_block_granularity - 1;
+  if (size != 0 && size_class < state_block_classes) {
+    auto *cache = state_block_cache::instance();
+    if (cache && cache->push(size_class, ptr))
+      return;
+  }
+#else
+  (void)size;
+#endif
+  ::operator delete(ptr);
+}
 
 [[noreturn]] void throw_no_state() {
   throw std::future_error{std::future_errc::no_state};
@@ -77,6 +284,270 @@ void future_state_base::push(continuation &&cnt) {
   this->continuations().push(std::move(cnt));
 }
 
+namespace {
+
+// worker identity of the calling thread, used to route posts to local deques
+thread_local const work_stealing_scheduler *current_scheduler = nullptr;
+thread_local std::size_t current_queue_index =
+    work_stealing_scheduler::no_local_queue;
+
+} // namespace
+
+constexpr std::size_t work_stealing_scheduler::no_local_queue;
+constexpr unsigned work_stealing_scheduler::max_lifo_streak;
+constexpr unsigned work_stealing_scheduler::shared_queue_interval;
+
+work_stealing_scheduler::work_stealing_scheduler(std::size_t num_local_queues) {
+  local_queues_.reserve(num_local_queues);
+  while (num_local_queues-- > 0)
+    local_queues_.push_back(std::make_unique<task_deque>());
+}
+
+// Tasks are counted in pending_ before closed_ is checked. A worker only exits
+// once it has seen closed_ and then pending_ == 0, so a push which does not see
+// closed_ is always waited for, and a push which does is rolled back.
+bool work_stealing_scheduler::reserve(std::size_t count) noexcept {
+  pending_.fetch_add(count);
+  if (!closed_.load())
+    return true;
+  pending_.fetch_sub(count);
+  return false;
+}
+
+bool work_stealing_scheduler::push(unique_function<void()> &&task) {
+  if (!reserve(1)) {
+    unique_function<void()> dropped = std::move(task);
+    return false;
+  }
+
+  task_deque &target = target_queue();
+  {
+    std::lock_guard<std::mutex> guard{target.mutex};
+    if (&target == &shared_queue_) {
+      target.tasks.emplace_back(std::move(task));
+    } else {
+      if (target.lifo_slot)
+        target.tasks.emplace_back(std::move(target.lifo_slot));
+      target.lifo_slot = std::move(task);
+    }
+  }
+  notify_sleepers(1);
+  return true;
+}
+
+bool work_stealing_scheduler::push_n(unique_function<void()> *tasks,
+                                     std::size_t count) {
+  if (count == 0)
+    return true;
+  if (!reserve(count)) {
+    for (std::size_t i = 0; i < count; ++i)
+      unique_function<void()> dropped = std::move(tasks[i]);
+    return false;
+  }
+
+  task_deque &target = target_queue();
+  {
+    std::lock_guard<std::mutex> guard{target.mutex};
+    for (std::size_t i = 0; i < count; ++i)
+      target.tasks.emplace_back(std::move(tasks[i]));
+  }
+  notify_sleepers(count);
+  return true;
+}
+
+namespace {
+
+struct bulk_job {
+  bulk_job(std::size_t count, unique_function<void(std::size_t)> &&func,
+           unique_function<void(std::exception_ptr)> &&completion)
+      : func(std::move(func)), completion(std::move(completion)),
+        count(count), remaining(count) {}
+
+  // a job still queued when the pool stops is dropped with its queue entries,
+  // completion is then told the indices will never run
+  ~bulk_job() {
+    if (completion && remaining.load(std::memory_order_acquire) != 0)
+      completion(make_broken_promise());
+  }
+
+  unique_function<void(std::size_t)> func;
+  unique_function<void(std::exception_ptr)> completion;
+  const std::size_t count;
+  std::atomic<std::size_t> next{0};
+  std::atomic<std::size_t> remaining;
+  // written once by the first failing index, published by remaining
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+};
+
+void run_bulk(work_stealing_scheduler &scheduler,
+              const std::shared_ptr<bulk_job> &job) {
+  // recruit one more worker while at least two indices are left, the recruit
+  // does the same: min(count, idle) workers end up sharing the index range
+  if (job->next.load(std::memory_order_relaxed) + 1 < job->count &&
+      scheduler.has_sleepers())
+    scheduler.push([&scheduler, job] { run_bulk(scheduler, job); });
+
+  for (;;) {
+    const std::size_t index = job->next.fetch_add(1, std::memory_order_relaxed);
+    if (index >= job->count)
+      return;
+    try {
+      job->func(index);
+    } catch (...) {
+      if (!job->failed.exchange(true, std::memory_order_relaxed))
+        job->error = std::current_exception();
+    }
+    if (job->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+        job->completion)
+      job->completion(std::move(job->error));
+  }
+}
+
+} // namespace
+
+bool work_stealing_scheduler::push_bulk(
+    std::size_t count, unique_function<void(std::size_t)> &&func,
+    unique_function<void(std::exception_ptr)> &&completion) {
+  if (count == 0) {
+    if (completion)
+      completion(nullptr);
+    return true;
+  }
+
+  auto job = std::make_shared<bulk_job>(count, std::move(func),
+                                        std::move(completion));
+  // refused by a closed scheduler: the job destructor reports broken_promise
+  return push([this, job] { run_bulk(*this, job); });
+}
+
+bool work_stealing_scheduler::pop(std::size_t queue_index,
+                                  unique_function<void()> &dest) {
+  const bool shared_first =
+      queue_index < local_queues_.size() &&
+      ++local_queues_[queue_index]->pop_tick % shared_queue_interval == 0;
+  for (;;) {
+    // a task reserved by a concurrent push may not be enqueued yet: pending_ is
+    // then positive and the loop retries until it shows up
+    if ((shared_first && try_pop_shared(dest)) ||
+        try_pop_local(queue_index, dest) || try_pop_shared(dest) ||
+        try_steal(queue_index, dest)) {
+      pending_.fetch_sub(1);
+      return true;
+    }
+
+    std::unique_lock<std::mutex> lock{sleep_mutex_};
+    sleepers_.fetch_add(1);
+    sleep_cv_.wait(lock, [this] {
+      return pending_.load() > 0 || closed_.load();
+    });
+    sleepers_.fetch_sub(1);
+    if (closed_.load() && pending_.load() == 0)
+      return false;
+  }
+}
+
+void work_stealing_scheduler::bind_current_thread(
+    std::size_t queue_index) noexcept {
+  current_scheduler = this;
+  current_queue_index = queue_index;
+}
+
+bool work_stealing_scheduler::is_current_thread_bound() const noexcept {
+  return current_scheduler == this;
+}
+
+void work_stealing_scheduler::close() {
+  {
+    std::lock_guard<std::mutex> guard{sleep_mutex_};
+    closed_.store(true);
+  }
+  sleep_cv_.notify_all();
+}
+
+bool work_stealing_scheduler::try_pop_local(std::size_t queue_index,
+                                            unique_function<void()> &dest) {
+  if (queue_index >= local_queues_.size())
+    return false;
+  task_deque &local = *local_queues_[queue_index];
+  std::lock_guard<std::mutex> guard{local.mutex};
+  if (local.lifo_slot &&
+      (local.lifo_streak < max_lifo_streak || local.tasks.empty())) {
+    ++local.lifo_streak;
+    std::swap(dest, local.lifo_slot);
+    local.lifo_slot = unique_function<void()>{};
+    return true;
+  }
+  local.lifo_streak = 0;
+  if (local.tasks.empty())
+    return false;
+  std::swap(dest, local.tasks.front());
+  local.tasks.pop_front();
+  return true;
+}
+
+bool work_stealing_scheduler::try_pop_shared(unique_function<void()> &dest) {
+  std::lock_guard<std::mutex> guard{shared_queue_.mutex};
+  if (shared_queue_.tasks.empty())
+    return false;
+  std::swap(dest, shared_queue_.tasks.front());
+  shared_queue_.tasks.pop_front();
+  return true;
+}
+
+bool work_stealing_scheduler::try_steal(std::size_t queue_index,
+                                        unique_function<void()> &dest) {
+  const std::size_t count = local_queues_.size();
+  const std::size_t first = queue_index < count ? queue_index + 1 : 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::size_t victim = (first + i) % count;
+    if (victim == queue_index)
+      continue;
+    task_deque &queue = *local_queues_[victim];
+    std::unique_lock<std::mutex> lock{queue.mutex, std::try_to_lock};
+    if (!lock.owns_lock())
+      continue;
+    if (!queue.tasks.empty()) {
+      std::swap(dest, queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+    if (queue.lifo_slot) {
+      std::swap(dest, queue.lifo_slot);
+      queue.lifo_slot = unique_function<void()>{};
+      return true;
+    }
+  }
+  return false;
+}
+
+bool work_stealing_scheduler::has_sleepers() const noexcept {
+  return sleepers_.load(std::memory_order_relaxed) > 0;
+}
+
+work_stealing_scheduler::task_deque &
+work_stealing_scheduler::target_queue() noexcept {
+  return (current_scheduler == this &&
+          current_queue_index < local_queues_.size())
+             ? *local_queues_[current_queue_index]
+             : shared_queue_;
+}
+
+// pending_ is incremented before sleepers_ is read, while a sleeper registers
+// itself before re-checking pending_, so one of them always sees the other.
+void work_stealing_scheduler::notify_sleepers(std::size_t count) {
+  const std::size_t sleepers = sleepers_.load();
+  if (sleepers == 0)
+    return;
+  std::lock_guard<std::mutex> guard{sleep_mutex_};
+  if (count >= sleepers) {
+    sleep_cv_.notify_all();
+    return;
+  }
+  while (count-- > 0)
+    sleep_cv_.notify_one();
+}
+
 } // namespace detail
 
 namespace {
@@ -85,11 +556,14 @@ namespace {
 // exception then std::terminate is called. This behavior is established by
 // marking this function noexcept.
 void process_queue(
-  detail::closable_queue<unique_function<void()>> &queue,
+  detail::work_stealing_scheduler &scheduler,
+  std::size_t queue_index,
   const std::atomic<bool> &stopped
 ) noexcept {
+  scheduler.bind_current_thread(queue_index);
   unique_function<void()> task;
-  while (!stopped.load(std::memory_order_relaxed) && queue.pop(task))
+  while (!stopped.load(std::memory_order_relaxed) &&
+         scheduler.pop(queue_index, task))
     task();
 }
 
@@ -170,10 +644,12 @@ future<when_any_result<std::tuple<>>> when_any() {
       static_cast<std::size_t>(-1), std::tuple<>{}});
 }
 
-static_thread_pool::static_thread_pool(std::size_t num_threads) {
+static_thread_pool::static_thread_pool(std::size_t num_threads)
+    : scheduler_{num_threads} {
   threads_.reserve(num_threads);
-  while (num_threads-- > 0)
-    threads_.push_back(std::thread{&static_thread_pool::attach, this});
+  for (std::size_t index = 0; index < num_threads; ++index)
+    threads_.push_back(
+        std::thread{&static_thread_pool::run_worker, this, index});
 }
 
 static_thread_pool::~static_thread_pool() {
@@ -181,12 +657,18 @@ static_thread_pool::~static_thread_pool() {
   wait();
 }
 
+// attached threads have no local deque: their posts go to the shared queue and
+// they only take work from the shared queue or by stealing
 void static_thread_pool::attach() {
+  run_worker(detail::work_stealing_scheduler::no_local_queue);
+}
+
+void static_thread_pool::run_worker(std::size_t queue_index) {
   {
     std::lock_guard<std::mutex> lock{mutex_};
     ++attached_threads_;
   }
-  process_queue(queue_, stopped_);
+  process_queue(scheduler_, queue_index, stopped_);
   {
     std::unique_lock<std::mutex> lock{mutex_};
     --attached_threads_;
@@ -197,11 +679,11 @@ void static_thread_pool::attach() {
 
 void static_thread_pool::stop() { 
   stopped_.store(true, std::memory_order_relaxed);
-  queue_.close();
+  scheduler_.close();
 }
 
 void static_thread_pool::wait() {
-  queue_.close();
+  scheduler_.close();
   for (auto &thread : threads_) {
     if (thread.joinable())
       thread.join();
@@ -41,7 +41,8 @@ template <typename T> struct promise_common {
       state_;
 
   promise_common()
-      : state_{in_place_index_t<1>{}, std::make_shared<shared_state<T>>()} {}
+      : state_{in_place_index_t<1>{}, std::allocate_shared<shared_state<T>>(
+                   state_allocator<shared_state<T>>{})} {}
   template <typename Alloc>
   explicit promise_common(const Alloc &allocator)
       : state_{in_place_index_t<1>{},
@@ -50,7 +51,8 @@ template <typename T> struct promise_common {
   template <typename F>
   promise_common(canceler_arg_t, F &&f)
       : state_{in_place_index_t<1>{},
-               std::make_shared<cancellable_state<T, std::decay_t<F>>>(
+               std::allocate_shared<cancellable_state<T, std::decay_t<F>>>(
+                   state_allocator<cancellable_state<T, std::decay_t<F>>>{},
                    std::forward<F>(f))} {}
 
   promise_common(std::weak_ptr<detail::shared_state<T>> &&state)
@@ -285,7 +287,8 @@ private:
 
 template <typename T>
 PC_NODISCARD std::pair<promise<T>, future<T>> make_promise() {
-  auto state = std::make_shared<detail::shared_state<T>>();
+  auto state = std::allocate_shared<detail::shared_state<T>>(
+      detail::state_allocator<detail::shared_state<T>>{});
   auto state_weak = std::weak_ptr<detail::shared_state<T>>(state);
   return {promise<T>(std::move(state_weak)), future<T>(std::move(state))};
 }
@@ -302,8 +305,9 @@ make_promise(const Alloc &allocator) {
 template <typename T, typename F>
 PC_NODISCARD std::pair<promise<T>, future<T>> make_promise(canceler_arg_t,
                                                            F &&f) {
-  auto state = std::make_shared<detail::cancellable_state<T, std::decay_t<F>>>(
-      std::forward<F>(f));
+  using state_t = detail::cancellable_state<T, std::decay_t<F>>;
+  auto state = std::allocate_shared<state_t>(
+      detail::state_allocator<state_t>{}, std::forward<F>(f));
   auto state_weak = std::weak_ptr<detail::shared_state<T>>(state);
   return {promise<T>(std::move(state_weak)), future<T>(std::move(state))};
 }
@@ -8,6 +8,7 @@
 #include "either.h"
 #include "future_state.h"
 #include "fwd.h"
+#include "state_allocator.h"
 
 namespace portable_concurrency {
 inline namespace cxx14_v1 {
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace portable_concurrency {
+inline namespace cxx14_v1 {
+namespace detail {
+
+void *allocate_state_block(std::size_t size);
+void deallocate_state_block(void *ptr, std::size_t size) noexcept;
+
+/**
+ * @internal
+ *
+ * Allocator used by default for shared states, continuation states and
+ * continuation nodes. Small blocks are recycled through thread local free lists
+ * (one per 16 bytes size class, bounded in length) so that high rate future
+ * chains stop hitting the global heap for every stage. A block released on
+ * another thread than the one which allocated it simply joins the free list of
+ * the releasing thread. Over-aligned types are forwarded to `std::allocator`.
+ *
+ * Defining `PC_DISABLE_STATE_POOL` at library build time makes every block go
+ * straight to the global heap.
+ */
+template <typename T> class state_allocator {
+public:
+  using value_type = T;
+
+  state_allocator() noexcept = default;
+  template <typename U> state_allocator(const state_allocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    if (alignof(T) > alignof(std::max_align_t))
+      return std::allocator<T>{}.allocate(n);
+    return static_cast<T *>(allocate_state_block(n * sizeof(T)));
+  }
+
+  void deallocate(T *ptr, std::size_t n) noexcept {
+    if (alignof(T) > alignof(std::max_align_t))
+      return std::allocator<T>{}.deallocate(ptr, n);
+    deallocate_state_block(ptr, n * sizeof(T));
+  }
+
+  template <typename U>
+  friend bool operator==(const state_allocator &,
+                         const state_allocator<U> &) noexcept {
+    return true;
+  }
+
+  template <typename U>
+  friend bool operator!=(const state_allocator &,
+                         const state_allocator<U> &) noexcept {
+    return false;
+  }
+};
+
+} // namespace detail
+} // namespace cxx14_v1
+} // namespace portable_concurrency
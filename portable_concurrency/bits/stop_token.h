@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <utility>
+
+#include "concurrency_type_traits.h"
+#include "invoke.h"
+
+namespace portable_concurrency {
+inline namespace cxx14_v1 {
+
+namespace detail {
+
+struct stop_state {
+  std::atomic<bool> requested{false};
+};
+
+} // namespace detail
+
+/**
+ * @headerfile portable_concurrency/stop_token
+ * @ingroup stop_token_hdr
+ * @brief Exception stored into the future of an operation skipped because its
+ * stop token was signaled before it started.
+ */
+class operation_cancelled : public std::exception {
+public:
+  const char *what() const noexcept override { return "operation cancelled"; }
+};
+
+/**
+ * @headerfile portable_concurrency/stop_token
+ * @ingroup stop_token_hdr
+ * @brief Read only view of a stop request made through a @ref stop_source
+ *
+ * Tokens are cheap to copy and to poll: `stop_requested()` is a single atomic
+ * load, so long running tasks may check it between iterations and return
+ * early. A default constructed token is never signaled.
+ */
+class stop_token {
+public:
+  stop_token() noexcept = default;
+
+  /// checks if a stop was requested through the associated stop_source
+  bool stop_requested() const noexcept {
+    return state_ && state_->requested.load(std::memory_order_acquire);
+  }
+
+  /// checks if the token is associated with a stop_source
+  bool stop_possible() const noexcept { return static_cast<bool>(state_); }
+
+private:
+  friend class stop_source;
+
+  explicit stop_token(std::shared_ptr<detail::stop_state> state) noexcept
+      : state_(std::move(state)) {}
+
+private:
+  std::shared_ptr<detail::stop_state> state_;
+};
+
+/**
+ * @headerfile portable_concurrency/stop_token
+ * @ingroup stop_token_hdr
+ * @brief Issues cooperative stop requests to the operations holding one of its
+ * tokens
+ *
+ * Copies of a stop_source share the same stop state. Stopping is cooperative:
+ * operations scheduled with a token through `async`, `stoppable` or
+ * `worker_task::delegate_async` are skipped if the stop was requested before
+ * they are dequeued, operations already running are expected to poll
+ * `stop_token::stop_requested()`.
+ */
+class stop_source {
+public:
+  stop_source() : state_(std::make_shared<detail::stop_state>()) {}
+
+  stop_token get_token() const noexcept { return stop_token{state_}; }
+
+  bool stop_requested() const noexcept {
+    return state_->requested.load(std::memory_order_acquire);
+  }
+
+  /// signals the stop, returns true if this call made the request
+  bool request_stop() noexcept {
+    return !state_->requested.exchange(true, std::memory_order_acq_rel);
+  }
+
+private:
+  std::shared_ptr<detail::stop_state> state_;
+};
+
+namespace detail {
+
+template <typename F> class stoppable_function {
+public:
+  template <typename U>
+  stoppable_function(stop_token token, U &&func)
+      : token_(std::move(token)), func_(std::forward<U>(func)) {}
+
+  template <typename... A>
+  invoke_result_t<F, A...> operator()(A &&...args) && {
+    if (token_.stop_requested())
+      throw operation_cancelled{};
+    return detail::invoke(std::move(func_), std::forward<A>(args)...);
+  }
+
+private:
+  stop_token token_;
+  F func_;
+};
+
+} // namespace detail
+
+/**
+ * @headerfile portable_concurrency/stop_token
+ * @ingroup stop_token_hdr
+ * @brief Makes a task or continuation skippable through a stop token
+ *
+ * The returned function object checks `token` right before invoking `func`.
+ * If a stop was requested it throws @ref operation_cancelled instead, which
+ * ends up in the future of the operation. Intended to be passed to
+ * `future::then`, `future::next` and `shared_future::then`:
+ * ```
+ * auto res = fut.next(exec, pc::stoppable(token, process));
+ * ```
+ * The function object is invoked at most once.
+ */
+template <typename F>
+detail::stoppable_function<std::decay_t<F>> stoppable(stop_token token,
+                                                      F &&func) {
+  return {std::move(token), std::forward<F>(func)};
+}
+
+} // namespace cxx14_v1
+} // namespace portable_concurrency
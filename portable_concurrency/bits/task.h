@@ -0,0 +1,213 @@
+#pragma once
+
+#include <exception>
+#include <utility>
+
+#include "coro.h"
+#include "either.h"
+#include "future.hpp"
+#include "future_state.h"
+#include "promise.h"
+#include "shared_state.h"
+
+#if defined(PC_HAS_SYMMETRIC_TRANSFER)
+
+namespace portable_concurrency {
+inline namespace cxx14_v1 {
+
+template <typename T = void> class task;
+
+namespace detail {
+
+template <typename T> struct task_result {
+  static T take(state_storage_t<T> &storage) { return std::move(storage); }
+};
+
+template <typename T> struct task_result<T &> {
+  static T &take(state_storage_t<T &> &storage) { return storage.get(); }
+};
+
+template <> struct task_result<void> {
+  static void take(state_storage_t<void> &) {}
+};
+
+template <typename T> class task_promise_base {
+public:
+  struct final_awaiter {
+    bool await_ready() const noexcept { return false; }
+
+    // symmetric transfer: the awaiting coroutine is resumed without growing
+    // the stack, whatever the depth of the chain
+    template <typename Promise>
+    coroutine_handle<> await_suspend(coroutine_handle<Promise> self) noexcept {
+      auto continuation = self.promise().continuation_;
+      return continuation ? continuation : noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  suspend_always initial_suspend() const noexcept { return {}; }
+  final_awaiter final_suspend() const noexcept { return {}; }
+
+  void unhandled_exception() noexcept {
+    result_.emplace(in_place_index_t<2>{}, std::current_exception());
+  }
+
+  void set_continuation(coroutine_handle<> continuation) noexcept {
+    continuation_ = continuation;
+  }
+
+  state_storage_t<T> &storage() {
+    if (result_.state() == 2)
+      std::rethrow_exception(result_.get(in_place_index_t<2>{}));
+    return result_.get(in_place_index_t<1>{});
+  }
+
+protected:
+  either<monostate, state_storage_t<T>, std::exception_ptr> result_;
+  coroutine_handle<> continuation_;
+};
+
+template <typename T> class task_promise : public task_promise_base<T> {
+public:
+  cxx14_v1::task<T> get_return_object() noexcept;
+
+  template <typename U> void return_value(U &&val) {
+    this->result_.emplace(in_place_index_t<1>{}, std::forward<U>(val));
+  }
+};
+
+template <typename T> class task_promise<T &> : public task_promise_base<T &> {
+public:
+  cxx14_v1::task<T &> get_return_object() noexcept;
+
+  void return_value(T &val) {
+    this->result_.emplace(in_place_index_t<1>{}, std::ref(val));
+  }
+};
+
+template <> class task_promise<void> : public task_promise_base<void> {
+public:
+  cxx14_v1::task<void> get_return_object() noexcept;
+
+  void return_void() { result_.emplace(in_place_index_t<1>{}, void_val{}); }
+};
+
+template <typename T> future<T> start_task(cxx14_v1::task<T> t) {
+  co_return co_await std::move(t);
+}
+
+} // namespace detail
+
+/**
+ * @headerfile portable_concurrency/task
+ * @ingroup task_hdr
+ * @brief Lazy coroutine type
+ *
+ * Unlike coroutines returning @ref future, a coroutine returning `task<T>` does
+ * not start until it is awaited, keeps its result in the coroutine frame
+ * instead of a heap allocated shared state and resumes its awaiter through
+ * symmetric transfer. Deep chains of tasks awaiting each other therefore cost
+ * a coroutine frame per call and nothing more.
+ *
+ * A task is awaited once. It can be converted to @ref future in order to be
+ * started eagerly and combined with continuations, `when_all` or `when_any`.
+ * Tasks may await futures and any other awaitable, e.g.
+ * `worker_task::schedule()` to hop onto a worker thread.
+ */
+template <typename T> class task {
+public:
+  using promise_type = detail::task_promise<T>;
+  using handle_type = detail::coroutine_handle<promise_type>;
+
+  task() noexcept = default;
+
+  task(const task &) = delete;
+  task &operator=(const task &) = delete;
+
+  task(task &&rhs) noexcept : handle_(std::exchange(rhs.handle_, nullptr)) {}
+  task &operator=(task &&rhs) noexcept {
+    if (this != &rhs) {
+      destroy();
+      handle_ = std::exchange(rhs.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  ~task() { destroy(); }
+
+  /// checks if the task refers to a coroutine
+  bool valid() const noexcept { return static_cast<bool>(handle_); }
+
+  /// checks if the coroutine has run to completion
+  bool is_ready() const noexcept { return handle_ && handle_.done(); }
+
+  class awaiter {
+  public:
+    explicit awaiter(handle_type handle) noexcept : handle_(handle) {}
+
+    bool await_ready() const noexcept { return !handle_ || handle_.done(); }
+
+    detail::coroutine_handle<>
+    await_suspend(detail::coroutine_handle<> awaiting) noexcept {
+      handle_.promise().set_continuation(awaiting);
+      return handle_;
+    }
+
+    T await_resume() {
+      if (!handle_)
+        detail::throw_no_state();
+      return detail::task_result<T>::take(handle_.promise().storage());
+    }
+
+  private:
+    handle_type handle_;
+  };
+
+  awaiter operator co_await() & noexcept { return awaiter{handle_}; }
+  awaiter operator co_await() && noexcept { return awaiter{handle_}; }
+
+  /// starts the task and provides its result through a future
+  operator future<T>() && { return detail::start_task(std::move(*this)); }
+
+private:
+  friend class detail::task_promise<T>;
+
+  explicit task(handle_type handle) noexcept : handle_(handle) {}
+
+  void destroy() noexcept {
+    if (handle_)
+      std::exchange(handle_, nullptr).destroy();
+  }
+
+private:
+  handle_type handle_;
+};
+
+namespace detail {
+
+// detail::task (async.h) hides the coroutine type in this namespace
+template <typename T>
+cxx14_v1::task<T> task_promise<T>::get_return_object() noexcept {
+  using task_type = cxx14_v1::task<T>;
+  return task_type{task_type::handle_type::from_promise(*this)};
+}
+
+template <typename T>
+cxx14_v1::task<T &> task_promise<T &>::get_return_object() noexcept {
+  using task_type = cxx14_v1::task<T &>;
+  return task_type{task_type::handle_type::from_promise(*this)};
+}
+
+inline cxx14_v1::task<void> task_promise<void>::get_return_object() noexcept {
+  using task_type = cxx14_v1::task<void>;
+  return task_type{task_type::handle_type::from_promise(*this)};
+}
+
+} // namespace detail
+
+} // namespace cxx14_v1
+} // namespace portable_concurrency
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "concurrency_type_traits.h"
 #include "execution.h"
+#include "executor_affinity.h"
 #include "shared_state.h"
 #include "utils.h"
 
@@ -221,7 +222,7 @@ template <typename R, typename F, typename E> struct cnt_state {
     E exec = std::move(self->exec.get(in_place_index_t<1>{}));
     self->exec.clean();
     std::weak_ptr<cnt_state> wstate = std::exchange(self, nullptr);
-    post(exec, cnt_action<cnt_state>{std::move(wstate)});
+    post_or_run(exec, cnt_action<cnt_state>{std::move(wstate)});
   }
 
   either<detail::monostate, E> exec;
@@ -233,7 +234,8 @@ template <typename R, typename E, typename F>
 auto make_then_state(continuations_stack &subscriptions, E &&exec, F &&f) {
   using cnt_data_t = cnt_state<R, std::decay_t<F>, std::decay_t<E>>;
 
-  auto data = std::make_shared<cnt_data_t>();
+  auto data =
+      std::allocate_shared<cnt_data_t>(state_allocator<cnt_data_t>{});
   data->exec.emplace(in_place_index_t<1>{}, std::forward<E>(exec));
   data->action.emplace(in_place_index_t<1>{}, std::forward<F>(f));
   subscriptions.push([wdata = std::weak_ptr<cnt_data_t>{data}] {
@@ -1,32 +1,54 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <exception>
+#include <mutex>
 #include <thread>
 #include <type_traits>
+#include <vector>
 
-#include "closable_queue.h"
 #include "execution.h"
 #include "unique_function.hpp"
+#include "work_stealing_scheduler.h"
 
 namespace portable_concurrency {
 inline namespace cxx14_v1 {
 
 namespace detail {
-extern template class closable_queue<unique_function<void()>>;
-
-class queue_executor {
+class scheduler_executor {
 public:
-  queue_executor(closable_queue<unique_function<void()>> *queue) noexcept
-      : queue_{queue} {}
+  scheduler_executor(work_stealing_scheduler *scheduler) noexcept
+      : scheduler_{scheduler} {}
 
 private:
-  friend void post(queue_executor exec, unique_function<void()> fun) {
-    exec.queue_->push(std::move(fun));
+  friend void post(scheduler_executor exec, unique_function<void()> fun) {
+    exec.scheduler_->push(std::move(fun));
+  }
+
+  /// post count tasks at once, moving them from the tasks array
+  friend void post_n(scheduler_executor exec, unique_function<void()> *tasks,
+                     std::size_t count) {
+    exec.scheduler_->push_n(tasks, count);
+  }
+
+  /// true on the pool threads: continuations scheduled there run in place
+  friend bool running_in_this_thread(scheduler_executor exec) noexcept {
+    return exec.scheduler_->is_current_thread_bound();
+  }
+
+  /// run func(i) for every i in [0, count) on the pool workers, then
+  /// completion with the first exception thrown by func (null if none was)
+  friend void
+  bulk_execute(scheduler_executor exec, std::size_t count,
+               unique_function<void(std::size_t)> func,
+               unique_function<void(std::exception_ptr)> completion = {}) {
+    exec.scheduler_->push_bulk(count, std::move(func), std::move(completion));
   }
 
 private:
-  closable_queue<unique_function<void()>> *queue_;
+  work_stealing_scheduler *scheduler_;
 };
 
 } // namespace detail
@@ -34,10 +56,15 @@ private:
 /**
  * @headerfile portable_concurrency/thread_pool
  * @ingroup thread_pool
+ *
+ * Each worker thread owns a local task deque and steals work from the other
+ * workers when it runs dry. Tasks posted from a worker thread (continuations,
+ * nested async calls) stay on that worker, tasks posted from other threads go
+ * through a shared injection queue.
  */
 class static_thread_pool {
 public:
-  using executor_type = detail::queue_executor;
+  using executor_type = detail::scheduler_executor;
 
   explicit static_thread_pool(std::size_t num_threads);
 
@@ -56,10 +83,13 @@ public:
   /// wait for all threads in the thread pool to complete
   void wait();
 
-  executor_type executor() noexcept { return {&queue_}; }
+  executor_type executor() noexcept { return {&scheduler_}; }
+
+private:
+  void run_worker(std::size_t queue_index);
 
 private:
-  detail::closable_queue<unique_function<void()>> queue_;
+  detail::work_stealing_scheduler scheduler_;
   std::vector<std::thread> threads_;
   unsigned attached_threads_ = 0;
   std::mutex mutex_;
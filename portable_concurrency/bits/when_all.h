@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -12,6 +13,7 @@
 #include "make_future.h"
 #include "shared_future.h"
 #include "shared_state.h"
+#include "stop_token.h"
 
 namespace portable_concurrency {
 inline namespace cxx14_v1 {
@@ -26,7 +28,8 @@ public:
         operations_remains_(sequence_traits<Sequence>::size(futures_) + 1) {}
 
   static std::shared_ptr<future_state<Sequence>> make(Sequence &&futures) {
-    auto state = std::make_shared<when_all_state<Sequence>>(std::move(futures));
+    auto state = std::allocate_shared<when_all_state<Sequence>>(
+        state_allocator<when_all_state<Sequence>>{}, std::move(futures));
     sequence_traits<Sequence>::for_each(state->futures_, [state](auto &f) {
       state_of(f)->continuations().push([state] { state->notify(); });
     });
@@ -58,6 +61,87 @@ private:
   continuations_stack continuations_;
 };
 
+/**
+ * @internal
+ *
+ * when_all state for homogeneous vectors of futures. Instead of allocating one
+ * continuation node (holding a shared_ptr to the state) per input future, all
+ * the nodes are embedded in a single array owned by the state: fan-in costs
+ * two allocations whatever the number of inputs. The state keeps itself alive
+ * until every node has been either executed or discarded by its input.
+ */
+template <typename Sequence>
+class when_all_vector_state final : public future_state<Sequence> {
+public:
+  when_all_vector_state(Sequence &&futures)
+      : futures_(std::move(futures)),
+        operations_remains_(futures_.size() + 1),
+        nodes_alive_(futures_.size()),
+        nodes_(new node[futures_.size()]) {}
+
+  static std::shared_ptr<future_state<Sequence>> make(Sequence &&futures) {
+    auto state = std::allocate_shared<when_all_vector_state<Sequence>>(
+        state_allocator<when_all_vector_state<Sequence>>{},
+        std::move(futures));
+    auto *raw_state = state.get();
+    if (!raw_state->futures_.empty())
+      state->self_ = state;
+    for (std::size_t i = 0; i < raw_state->futures_.size(); ++i) {
+      node &cnt_node = raw_state->nodes_[i];
+      cnt_node.state = raw_state;
+      cnt_node.val = [raw_state] { raw_state->notify(); };
+      state_of(raw_state->futures_[i])
+          ->continuations()
+          .push(forward_list<continuation>{&cnt_node});
+    }
+    raw_state->notify();
+    return state;
+  }
+
+  Sequence &value_ref() override {
+    assert(continuations_.executed());
+    return futures_;
+  }
+
+  std::exception_ptr exception() override {
+    assert(continuations_.executed());
+    return nullptr;
+  }
+
+  continuations_stack &continuations() final { return continuations_; }
+
+private:
+  struct node final : forward_list_node<continuation> {
+    node() : forward_list_node<continuation>(continuation{}) {}
+
+    // embedded in the state: releasing the node only drops a keep alive count
+    void deallocate_self() override { state->release_node(); }
+
+    when_all_vector_state *state = nullptr;
+  };
+
+  void notify() {
+    if (--operations_remains_ != 0)
+      return;
+    continuations_.execute();
+  }
+
+  void release_node() {
+    if (nodes_alive_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+      return;
+    // may destroy this object, nothing must be touched afterwards
+    auto self = std::move(self_);
+  }
+
+private:
+  Sequence futures_;
+  std::atomic<size_t> operations_remains_;
+  std::atomic<size_t> nodes_alive_;
+  std::unique_ptr<node[]> nodes_;
+  std::shared_ptr<when_all_vector_state> self_;
+  continuations_stack continuations_;
+};
+
 } // namespace detail
 
 PC_NODISCARD future<std::tuple<>> when_all();
@@ -115,7 +199,7 @@ PC_NODISCARD auto when_all(InputIt first, InputIt last) -> std::enable_if_t<
       std::vector<typename std::iterator_traits<InputIt>::value_type>;
   if (first == last)
     return make_ready_future(Sequence{});
-  return {detail::when_all_state<Sequence>::make(
+  return {detail::when_all_vector_state<Sequence>::make(
       Sequence{std::make_move_iterator(first), std::make_move_iterator(last)})};
 }
 
@@ -128,7 +212,8 @@ PC_NODISCARD auto when_all(InputIt first, InputIt last) -> std::enable_if_t<
       std::vector<typename std::iterator_traits<InputIt>::value_type>;
   if (first == last)
     return make_ready_future(Sequence{});
-  return {detail::when_all_state<Sequence>::make(Sequence{first, last})};
+  return {
+      detail::when_all_vector_state<Sequence>::make(Sequence{first, last})};
 }
 #endif
 
@@ -154,7 +239,68 @@ PC_NODISCARD auto when_all(std::vector<Future, Alloc> futures)
     -> std::enable_if_t<detail::is_future<Future>::value,
                         future<std::vector<Future, Alloc>>> {
   using Sequence = std::vector<Future, Alloc>;
-  return {detail::when_all_state<Sequence>::make(std::move(futures))};
+  return {detail::when_all_vector_state<Sequence>::make(std::move(futures))};
+}
+#endif
+
+namespace detail {
+
+// requests a stop as soon as the future completes with an exception
+template <typename Future>
+void request_stop_on_error(Future &future, stop_source source) {
+  auto &state = state_of(future);
+  std::weak_ptr<typename std::decay_t<decltype(state)>::element_type> weak =
+      state;
+  state->continuations().push([weak, source]() mutable {
+    auto ready = weak.lock();
+    if (ready && ready->exception())
+      source.request_stop();
+  });
+}
+
+} // namespace detail
+
+/**
+ * @ingroup future_hdr
+ *
+ * Same as `when_all(futures...)` and additionally requests a stop through
+ * `source` as soon as one of the input futures completes with an exception.
+ * Remaining operations started with a token of `source` are then skipped or
+ * may return early instead of computing results nobody will use.
+ */
+#ifdef DOXYGEN
+template <typename... Futures>
+future<std::tuple<Futures...>> when_all(stop_source source, Futures &&...);
+#else
+template <typename... Futures>
+PC_NODISCARD auto when_all(stop_source source, Futures &&...futures)
+    -> std::enable_if_t<detail::are_futures<std::decay_t<Futures>...>::value,
+                        future<std::tuple<std::decay_t<Futures>...>>> {
+  detail::swallow{(detail::request_stop_on_error(futures, source), 0)...};
+  return when_all(std::forward<Futures>(futures)...);
+}
+#endif
+
+/**
+ * @ingroup future_hdr
+ *
+ * Same as `when_all(std::move(futures))` and additionally requests a stop
+ * through `source` as soon as one of the input futures completes with an
+ * exception.
+ */
+#ifdef DOXYGEN
+template <typename Future, typename Alloc>
+future<std::vector<Future, Alloc>> when_all(stop_source source,
+                                            std::vector<Future, Alloc> futures);
+#else
+template <typename Future, typename Alloc>
+PC_NODISCARD auto when_all(stop_source source,
+                           std::vector<Future, Alloc> futures)
+    -> std::enable_if_t<detail::is_future<Future>::value,
+                        future<std::vector<Future, Alloc>>> {
+  for (auto &fut : futures)
+    detail::request_stop_on_error(fut, source);
+  return when_all(std::move(futures));
 }
 #endif
 
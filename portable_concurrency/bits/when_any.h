@@ -12,6 +12,7 @@
 #include "make_future.h"
 #include "shared_future.h"
 #include "shared_state.h"
+#include "stop_token.h"
 
 namespace portable_concurrency {
 inline namespace cxx14_v1 {
@@ -49,7 +50,8 @@ public:
 
   static std::shared_ptr<future_state<when_any_result<Sequence>>>
   make(Sequence &&seq) {
-    auto state = std::make_shared<when_any_state<Sequence>>(std::move(seq));
+    auto state = std::allocate_shared<when_any_state<Sequence>>(
+        state_allocator<when_any_state<Sequence>>{}, std::move(seq));
     std::size_t idx = 0;
     sequence_traits<Sequence>::for_each(
         state->result_.futures, [state, &idx](auto &f) mutable {
@@ -194,5 +196,63 @@ PC_NODISCARD auto when_any(std::vector<Future, Alloc> futures)
 }
 #endif
 
+namespace detail {
+
+// the stop is requested before the when_any result is made observable
+struct request_stop_on_ready {
+  stop_source source;
+
+  template <typename Result> Result operator()(Result res) {
+    source.request_stop();
+    return res;
+  }
+};
+
+} // namespace detail
+
+/**
+ * @ingroup future_hdr
+ *
+ * Same as `when_any(futures...)` and additionally requests a stop through
+ * `source` once one of the input futures is ready. The losing operations
+ * started with a token of `source` are then skipped if still queued and may
+ * poll the token to return early if already running.
+ */
+#ifdef DOXYGEN
+template <typename... Futures>
+future<when_any_result<std::tuple<Futures...>>> when_any(stop_source source,
+                                                         Futures &&...);
+#else
+template <typename... Futures>
+PC_NODISCARD auto when_any(stop_source source, Futures &&...futures)
+    -> std::enable_if_t<
+        detail::are_futures<std::decay_t<Futures>...>::value,
+        future<when_any_result<std::tuple<std::decay_t<Futures>...>>>> {
+  return when_any(std::forward<Futures>(futures)...)
+      .next(detail::request_stop_on_ready{std::move(source)});
+}
+#endif
+
+/**
+ * @ingroup future_hdr
+ *
+ * Same as `when_any(std::move(futures))` and additionally requests a stop
+ * through `source` once one of the input futures is ready.
+ */
+#ifdef DOXYGEN
+template <typename Future, typename Alloc>
+future<when_any_result<std::vector<Future, Alloc>>>
+when_any(stop_source source, std::vector<Future, Alloc> futures);
+#else
+template <typename Future, typename Alloc>
+PC_NODISCARD auto when_any(stop_source source,
+                           std::vector<Future, Alloc> futures)
+    -> std::enable_if_t<detail::is_future<Future>::value,
+                        future<when_any_result<std::vector<Future, Alloc>>>> {
+  return when_any(std::move(futures))
+      .next(detail::request_stop_on_ready{std::move(source)});
+}
+#endif
+
 } // namespace cxx14_v1
 } // namespace portable_concurrency
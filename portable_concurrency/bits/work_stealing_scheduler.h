@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "unique_function.hpp"
+
+namespace portable_concurrency {
+inline namespace cxx14_v1 {
+namespace detail {
+
+/**
+ * Task scheduler of the static_thread_pool.
+ *
+ * Every worker owns a local queue: a LIFO slot holding its most recent post in
+ * front of a FIFO deque. Tasks posted from inside a worker go to its own queue,
+ * tasks posted from outside of the pool go to a shared injection queue. An idle
+ * worker runs its local queue, then the injection queue, then steals the oldest
+ * tasks of the other workers. Each queue has its own lock, so posting and
+ * popping only contend when a worker runs out of local work.
+ *
+ * The LIFO slot keeps a just posted continuation hot in cache, but is bypassed
+ * after a few consecutive uses, and the injection queue is checked first every
+ * few pops, so a worker re-posting to itself starves neither its older tasks
+ * nor the injected ones.
+ */
+class work_stealing_scheduler {
+public:
+  static constexpr std::size_t no_local_queue = static_cast<std::size_t>(-1);
+
+  explicit work_stealing_scheduler(std::size_t num_local_queues);
+
+  work_stealing_scheduler(const work_stealing_scheduler &) = delete;
+  work_stealing_scheduler &operator=(const work_stealing_scheduler &) = delete;
+
+  /// enqueue a task, false if the scheduler is closed: the task is then
+  /// destroyed, which breaks the promise of a packaged task
+  bool push(unique_function<void()> &&task);
+
+  /// enqueue count tasks under a single lock and wake at most min(count, idle)
+  /// workers, tasks are moved from (destroyed if the scheduler is closed)
+  bool push_n(unique_function<void()> *tasks, std::size_t count);
+
+  /// enqueue a single entry running func(0) ... func(count - 1), recruiting
+  /// idle workers while indices remain; completion runs after the last call
+  /// with the first exception thrown by func, or null if none was. If the
+  /// scheduler is closed completion runs at once with broken_promise and false
+  /// is returned, a job dropped unstarted by a stopped pool gets the same.
+  bool push_bulk(std::size_t count, unique_function<void(std::size_t)> &&func,
+                 unique_function<void(std::exception_ptr)> &&completion);
+
+  /// block until a task is available, false once closed and drained
+  bool pop(std::size_t queue_index, unique_function<void()> &dest);
+
+  /// true if some workers are parked waiting for work
+  bool has_sleepers() const noexcept;
+
+  /// register the calling thread as the owner of the given local queue
+  void bind_current_thread(std::size_t queue_index) noexcept;
+
+  /// true if the calling thread is one of this scheduler workers
+  bool is_current_thread_bound() const noexcept;
+
+  void close();
+
+private:
+  struct task_deque {
+    std::mutex mutex;
+    std::deque<unique_function<void()>> tasks;
+    unique_function<void()> lifo_slot; // local queues only
+    // owner thread only
+    unsigned lifo_streak = 0;
+    unsigned pop_tick = 0;
+  };
+
+  /// consecutive pops served by the LIFO slot before the deque gets a turn
+  static constexpr unsigned max_lifo_streak = 3;
+  /// a worker checks the injection queue first once every that many pops
+  static constexpr unsigned shared_queue_interval = 61;
+
+  bool reserve(std::size_t count) noexcept;
+
+  bool try_pop_local(std::size_t queue_index, unique_function<void()> &dest);
+  bool try_pop_shared(unique_function<void()> &dest);
+  bool try_steal(std::size_t queue_index, unique_function<void()> &dest);
+  task_deque &target_queue() noexcept;
+  void notify_sleepers(std::size_t count);
+
+private:
+  std::vector<std::unique_ptr<task_deque>> local_queues_;
+  task_deque shared_queue_;
+  std::atomic<std::size_t> pending_{0};
+  std::atomic<std::size_t> sleepers_{0};
+  std::atomic<bool> closed_{false};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+};
+
+} // namespace detail
+} // namespace cxx14_v1
+} // namespace portable_concurrency
@@ -11,6 +11,7 @@
 #include "bits/algo_adapters.h"
 #include "bits/alias_namespace.h"
 #include "bits/async.h"
+#include "bits/fuse.h"
 #include "bits/future.hpp"
 #include "bits/make_future.h"
 #include "bits/packaged_task.h"
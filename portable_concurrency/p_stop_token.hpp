@@ -0,0 +1,12 @@
+// <stop_token> -*- C++ -*-
+#pragma once
+
+/**
+ * @defgroup stop_token_hdr <portable_concurrency/stop_token>
+ * @headerfile portable_concurrency/stop_token
+ *
+ * Cooperative cancellation of asynchronous operations
+ */
+
+#include "bits/alias_namespace.h"
+#include "bits/stop_token.h"
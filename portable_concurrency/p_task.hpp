@@ -0,0 +1,12 @@
+// <task> -*- C++ -*-
+#pragma once
+
+/**
+ * @defgroup task_hdr <portable_concurrency/task>
+ * @headerfile portable_concurrency/task
+ *
+ * Lazy coroutine `task` type storing its result in the coroutine frame
+ */
+
+#include "bits/alias_namespace.h"
+#include "bits/task.h"
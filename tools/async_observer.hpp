@@ -67,6 +67,23 @@ namespace tools
         async_observer() = default;
         virtual ~async_observer() = default;
 
+        // allocator aware construction of the event queue (e.g. with Sync_Container = pmr_sync_queue)
+#if (__cplusplus >= 202002L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L))
+        template <typename Alloc>
+            requires std::is_constructible_v<Sync_Container<event_entry>, const Alloc&>
+        explicit async_observer(const Alloc& alloc)
+            : m_evt_queue(alloc)
+        {
+        }
+#else
+        template <typename Alloc,
+            typename = std::enable_if_t<std::is_constructible_v<Sync_Container<event_entry>, const Alloc&>>>
+        explicit async_observer(const Alloc& alloc)
+            : m_evt_queue(alloc)
+        {
+        }
+#endif
+
         void inform(const Topic& topic, const Evt& event, const std::string& origin) override
         {
             // Virtual observer API keeps const references; enqueue copies into async storage.
@@ -0,0 +1,316 @@
+/**
+ * @file concurrent_histogram.hpp
+ * @brief Sharded log-linear histogram recorded concurrently without contention.
+ * @author Laurent Lardinois
+ * @date October 2026
+ */
+
+//-----------------------------------------------------------------------------//
+// C++ Publish/Subscribe Pattern - Spare time development for fun              //
+// (c) 2025-2026 Laurent Lardinois https://be.linkedin.com/in/laurentlardinois //
+//                                                                             //
+// https://github.com/type-one/PublishSubscribe                                //
+//                                                                             //
+// MIT License                                                                 //
+//                                                                             //
+// This software is provided 'as-is', without any express or implied           //
+// warranty.In no event will the authors be held liable for any damages        //
+// arising from the use of this software.                                      //
+//                                                                             //
+// Permission is granted to anyone to use this software for any purpose,       //
+// including commercial applications, and to alter itand redistribute it       //
+// freely, subject to the following restrictions :                             //
+//                                                                             //
+// 1. The origin of this software must not be misrepresented; you must not     //
+// claim that you wrote the original software.If you use this software         //
+// in a product, an acknowledgment in the product documentation would be       //
+// appreciated but is not required.                                            //
+// 2. Altered source versions must be plainly marked as such, and must not be  //
+// misrepresented as being the original software.                              //
+// 3. This notice may not be removed or altered from any source distribution.  //
+//-----------------------------------------------------------------------------//
+
+#pragma once
+
+#if !defined(CONCURRENT_HISTOGRAM_HPP_)
+#define CONCURRENT_HISTOGRAM_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "tools/hdr_histogram.hpp"
+#include "tools/non_copyable.hpp"
+
+namespace tools
+{
+    /**
+     * @brief Thread-safe hdr_histogram recorded from many threads without locks.
+     *
+     * Each recording thread registers its own shard on first use (bucket array on separate
+     * cache lines). A shard has a single writer, so recording is a relaxed load and store per
+     * field, no read-modify-write. A reader merges the shards into an hdr_histogram snapshot
+     * on demand.
+     */
+    class concurrent_histogram : public non_copyable // NOLINT inherits from non copyable/non movable
+    {
+    public:
+        struct thread_safe
+        {
+            static constexpr bool value = true;
+        };
+
+        /**
+         * @param highest_trackable_value Values above are clamped (see hdr_histogram).
+         * @param precision_bits Sub-bucket bits (see hdr_histogram).
+         */
+        explicit concurrent_histogram(
+            std::uint64_t highest_trackable_value = hdr_histogram::default_highest_trackable_value,
+            int precision_bits = hdr_histogram::default_precision_bits)
+            : m_layout { highest_trackable_value, precision_bits }
+            , m_nb_lines { (m_layout.bucket_count() + counters_per_line - 1U) / counters_per_line }
+            , m_id { next_histogram_id() }
+        {
+        }
+
+        ~concurrent_histogram()
+        {
+            shard* current = m_shards.load(std::memory_order_acquire);
+            while (nullptr != current)
+            {
+                std::unique_ptr<shard> owned(current);
+                current = current->m_next;
+            }
+        }
+
+        /**
+         * @brief Records a value into the shard of the calling thread (lock-free).
+         *
+         * The first record of a thread allocates its shard (may throw std::bad_alloc).
+         *
+         * @param value The value to record.
+         * @param count Number of occurrences of the value.
+         */
+        void record(std::uint64_t value, std::uint64_t count = 1U)
+        {
+            auto& local = local_shard();
+
+            // lazy clear of the shard by its owner after a reset
+            const auto generation = m_generation.load(std::memory_order_relaxed);
+            if (local.m_owner_generation != generation)
+            {
+                clear_shard(local, generation);
+            }
+
+            if (value > m_layout.m_highest_trackable_value)
+            {
+                value = m_layout.m_highest_trackable_value;
+                local.m_owner_clamped_count += count;
+                local.m_clamped_count.store(local.m_owner_clamped_count, std::memory_order_relaxed);
+            }
+
+            const std::size_t idx = m_layout.bucket_index(value);
+            auto& counter = local.m_lines[idx / counters_per_line].m_counts[idx % counters_per_line];
+            counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+
+            local.m_owner_sum += value * count;
+            local.m_sum.store(local.m_owner_sum, std::memory_order_relaxed);
+
+            if (value < local.m_owner_min)
+            {
+                local.m_owner_min = value;
+                local.m_min.store(value, std::memory_order_relaxed);
+            }
+
+            if (value > local.m_owner_max)
+            {
+                local.m_owner_max = value;
+                local.m_max.store(value, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Merges the shards into a histogram.
+         *
+         * Counters are read with relaxed loads while other threads keep recording, so
+         * the snapshot is consistent per bucket but not across buckets.
+         */
+        [[nodiscard]] hdr_histogram snapshot() const
+        {
+            hdr_histogram merged = m_layout;
+            const auto generation = m_generation.load(std::memory_order_acquire);
+
+            for (const shard* local = m_shards.load(std::memory_order_acquire); nullptr != local;
+                 local = local->m_next)
+            {
+                // shards not cleared since the last reset are empty
+                if (local->m_generation.load(std::memory_order_acquire) != generation)
+                {
+                    continue;
+                }
+
+                for (std::size_t idx = 0U; idx < merged.m_counts.size(); ++idx)
+                {
+                    const auto& counter = local->m_lines[idx / counters_per_line].m_counts[idx % counters_per_line];
+                    const auto count = counter.load(std::memory_order_relaxed);
+                    merged.m_counts[idx] += count;
+                    merged.m_total_count += count;
+                }
+
+                merged.m_clamped_count += local->m_clamped_count.load(std::memory_order_relaxed);
+                merged.m_sum += static_cast<double>(local->m_sum.load(std::memory_order_relaxed));
+                merged.m_min = std::min(merged.m_min, local->m_min.load(std::memory_order_relaxed));
+                merged.m_max = std::max(merged.m_max, local->m_max.load(std::memory_order_relaxed));
+            }
+
+            return merged;
+        }
+
+        /**
+         * @brief Clears all the shards in O(1) (samples recorded concurrently may be dropped).
+         *
+         * Each shard is cleared by its owner on its next record, a snapshot skips the shards
+         * not cleared yet.
+         */
+        void reset() noexcept
+        {
+            m_generation.fetch_add(1U, std::memory_order_acq_rel);
+        }
+
+        /**
+         * @brief Returns the number of threads which recorded into this histogram.
+         */
+        [[nodiscard]] std::size_t shard_count() const noexcept
+        {
+            std::size_t count = 0U;
+            for (const shard* local = m_shards.load(std::memory_order_acquire); nullptr != local;
+                 local = local->m_next)
+            {
+                ++count;
+            }
+            return count;
+        }
+
+    private:
+        static constexpr std::size_t cache_line_size = 64U;
+        static constexpr std::size_t counters_per_line = cache_line_size / sizeof(std::atomic<std::uint64_t>);
+        static constexpr std::size_t shard_cache_size = 4U;
+
+        struct alignas(cache_line_size) bucket_line
+        {
+            std::array<std::atomic<std::uint64_t>, counters_per_line> m_counts = {};
+        };
+
+        // per thread shard, summary on its own cache line, bucket lines allocated separately
+        struct alignas(cache_line_size) shard
+        {
+            std::unique_ptr<bucket_line[]> m_lines;
+            std::atomic<std::uint64_t> m_clamped_count = 0U;
+            std::atomic<std::uint64_t> m_sum = 0U;
+            std::atomic<std::uint64_t> m_min = std::numeric_limits<std::uint64_t>::max();
+            std::atomic<std::uint64_t> m_max = 0U;
+            std::atomic<std::uint64_t> m_generation = 0U; // reset generation the counters belong to
+
+            // owner only copies of the summary, the atomics above are written, never read, by the owner
+            std::uint64_t m_owner_clamped_count = 0U;
+            std::uint64_t m_owner_sum = 0U;
+            std::uint64_t m_owner_min = std::numeric_limits<std::uint64_t>::max();
+            std::uint64_t m_owner_max = 0U;
+            std::uint64_t m_owner_generation = 0U;
+
+            std::thread::id m_owner;
+            shard* m_next = nullptr; // immutable once published
+        };
+
+        // last shards used by the calling thread, keyed by histogram id (ids are never reused)
+        struct shard_cache_entry
+        {
+            std::uint64_t m_histogram_id = 0U;
+            shard* m_shard = nullptr;
+        };
+
+        static std::uint64_t next_histogram_id() noexcept
+        {
+            static std::atomic<std::uint64_t> next_id = 1U;
+            return next_id.fetch_add(1U, std::memory_order_relaxed);
+        }
+
+        shard& local_shard()
+        {
+            thread_local std::array<shard_cache_entry, shard_cache_size> cache = {};
+            auto& entry = cache[m_id % shard_cache_size];
+
+            if (m_id != entry.m_histogram_id)
+            {
+                entry.m_shard = find_or_register_shard();
+                entry.m_histogram_id = m_id;
+            }
+
+            return *entry.m_shard;
+        }
+
+        // slow path on a thread cache miss
+        shard* find_or_register_shard()
+        {
+            const auto owner = std::this_thread::get_id();
+
+            // the shard of an exited thread is taken over by a thread reusing its id
+            for (shard* local = m_shards.load(std::memory_order_acquire); nullptr != local; local = local->m_next)
+            {
+                if (owner == local->m_owner)
+                {
+                    return local;
+                }
+            }
+
+            auto fresh = std::make_unique<shard>();
+            fresh->m_lines = std::make_unique<bucket_line[]>(m_nb_lines);
+            fresh->m_owner = owner;
+            fresh->m_owner_generation = m_generation.load(std::memory_order_relaxed);
+            fresh->m_generation.store(fresh->m_owner_generation, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> guard(m_register_mtx);
+            fresh->m_next = m_shards.load(std::memory_order_relaxed);
+            m_shards.store(fresh.get(), std::memory_order_release);
+            return fresh.release();
+        }
+
+        void clear_shard(shard& local, std::uint64_t generation) noexcept
+        {
+            for (std::size_t line = 0U; line < m_nb_lines; ++line)
+            {
+                for (auto& counter : local.m_lines[line].m_counts)
+                {
+                    counter.store(0U, std::memory_order_relaxed);
+                }
+            }
+
+            local.m_owner_clamped_count = 0U;
+            local.m_owner_sum = 0U;
+            local.m_owner_min = std::numeric_limits<std::uint64_t>::max();
+            local.m_owner_max = 0U;
+            local.m_owner_generation = generation;
+
+            local.m_clamped_count.store(0U, std::memory_order_relaxed);
+            local.m_sum.store(0U, std::memory_order_relaxed);
+            local.m_min.store(local.m_owner_min, std::memory_order_relaxed);
+            local.m_max.store(0U, std::memory_order_relaxed);
+            local.m_generation.store(generation, std::memory_order_release);
+        }
+
+        hdr_histogram m_layout; // empty histogram giving the bucket layout
+        std::size_t m_nb_lines;
+        std::uint64_t m_id;
+        std::atomic<std::uint64_t> m_generation = 0U;
+        std::atomic<shard*> m_shards = nullptr; // push-only list, readers traverse it without lock
+        std::mutex m_register_mtx;
+    };
+}
+
+#endif //  CONCURRENT_HISTOGRAM_HPP_
@@ -0,0 +1,316 @@
+/**
+ * @file frame_arena.hpp
+ * @brief Per-tick frame arena (bump-pointer allocation reset at the end of each tick).
+ * @author Laurent Lardinois
+ * @date October 2026
+ */
+
+//-----------------------------------------------------------------------------//
+// C++ Publish/Subscribe Pattern - Spare time development for fun              //
+// (c) 2025-2026 Laurent Lardinois https://be.linkedin.com/in/laurentlardinois //
+//                                                                             //
+// https://github.com/type-one/PublishSubscribe                                //
+//                                                                             //
+// MIT License                                                                 //
+//                                                                             //
+// This software is provided 'as-is', without any express or implied           //
+// warranty.In no event will the authors be held liable for any damages        //
+// arising from the use of this software.                                      //
+//                                                                             //
+// Permission is granted to anyone to use this software for any purpose,       //
+// including commercial applications, and to alter itand redistribute it       //
+// freely, subject to the following restrictions :                             //
+//                                                                             //
+// 1. The origin of this software must not be misrepresented; you must not     //
+// claim that you wrote the original software.If you use this software         //
+// in a product, an acknowledgment in the product documentation would be       //
+// appreciated but is not required.                                            //
+// 2. Altered source versions must be plainly marked as such, and must not be  //
+// misrepresented as being the original software.                              //
+// 3. This notice may not be removed or altered from any source distribution.  //
+//-----------------------------------------------------------------------------//
+
+#pragma once
+
+#if !defined(FRAME_ARENA_HPP_)
+#define FRAME_ARENA_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <new>
+
+#include "tools/non_copyable.hpp"
+
+namespace tools
+{
+    /**
+     * @brief Bump-pointer arena for the short-lived allocations of one periodic tick.
+     *
+     * Allocation moves a cursor in a preallocated buffer, deallocation is a no-op and
+     * reset() rewinds the cursor in O(1), typically at the end of each periodic_task tick
+     * (see frame_arena_scope). Requests beyond the buffer are served by the upstream
+     * resource and released at the next reset, after which the buffer grows to the
+     * peak usage, so steady-state ticks do no heap allocation at all.
+     *
+     * The arena is also a std::pmr::memory_resource (pmr containers take its address)
+     * and frame_arena_allocator adapts it to the STL allocator model.
+     * Not thread-safe: meant to be owned by the thread running the ticks.
+     */
+    class frame_arena : public std::pmr::memory_resource, public non_copyable // NOLINT inherits from non copyable
+    {
+    public:
+        frame_arena() = delete;
+
+        explicit frame_arena(
+            std::size_t capacity, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : m_upstream { upstream }
+        {
+            grow(capacity);
+        }
+
+        ~frame_arena() override
+        {
+            release_overflow();
+            if (nullptr != m_buffer)
+            {
+                m_upstream->deallocate(m_buffer, m_capacity, buffer_alignment);
+            }
+        }
+
+        /**
+         * @brief Gives back every allocation of the current frame.
+         *
+         * O(1) unless the frame overflowed the buffer, in which case the overflow blocks
+         * are released and the buffer is enlarged to the peak usage (kept as is if the
+         * upstream resource cannot provide it, whatever it throws).
+         */
+        void reset() noexcept
+        {
+            const std::size_t frame_usage = m_offset + m_overflow_bytes;
+            m_high_water_mark = std::max(m_high_water_mark, frame_usage);
+            m_offset = 0U;
+
+            if (nullptr != m_overflow)
+            {
+                release_overflow();
+
+                try
+                {
+                    grow(frame_usage);
+                }
+                catch (...)
+                {
+                    // grow() only commits once the upstream allocation succeeded: keep the current buffer, the
+                    // next frames overflow again
+                }
+            }
+        }
+
+        [[nodiscard]] std::size_t capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        // bytes used by the current frame (buffer and overflow)
+        [[nodiscard]] std::size_t used() const noexcept
+        {
+            return m_offset + m_overflow_bytes;
+        }
+
+        // peak bytes used by a frame (updated at each reset)
+        [[nodiscard]] std::size_t high_water_mark() const noexcept
+        {
+            return std::max(m_high_water_mark, used());
+        }
+
+        // allocations served by the upstream resource since construction
+        [[nodiscard]] std::uint64_t overflow_allocations() const noexcept
+        {
+            return m_overflow_allocations;
+        }
+
+    private:
+        // header of a block allocated from the upstream resource when the buffer is full
+        struct overflow_block
+        {
+            overflow_block* m_next;
+            std::size_t m_size;
+            std::size_t m_alignment;
+        };
+
+        static constexpr std::size_t buffer_alignment = alignof(std::max_align_t);
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            const auto base = reinterpret_cast<std::uintptr_t>(m_buffer);
+            const auto aligned = (base + m_offset + alignment - 1U) & ~(static_cast<std::uintptr_t>(alignment) - 1U);
+            const std::size_t start = aligned - base;
+
+            if ((start <= m_capacity) && (bytes <= (m_capacity - start)))
+            {
+                m_offset = start + bytes;
+                return m_buffer + start;
+            }
+
+            return allocate_overflow(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            // released all at once by reset()
+            (void)ptr;
+            (void)bytes;
+            (void)alignment;
+        }
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        void* allocate_overflow(std::size_t bytes, std::size_t alignment)
+        {
+            const std::size_t block_alignment = std::max(alignment, alignof(overflow_block));
+            const std::size_t header_size
+                = ((sizeof(overflow_block) + block_alignment - 1U) / block_alignment) * block_alignment;
+            const std::size_t total_size = header_size + bytes;
+
+            auto* raw = static_cast<std::byte*>(m_upstream->allocate(total_size, block_alignment));
+            m_overflow = new (raw) overflow_block { m_overflow, total_size, block_alignment };
+            m_overflow_bytes += bytes;
+            ++m_overflow_allocations;
+
+            return raw + header_size;
+        }
+
+        void release_overflow() noexcept
+        {
+            while (nullptr != m_overflow)
+            {
+                overflow_block* next = m_overflow->m_next;
+                m_upstream->deallocate(m_overflow, m_overflow->m_size, m_overflow->m_alignment);
+                m_overflow = next;
+            }
+            m_overflow_bytes = 0U;
+        }
+
+        void grow(std::size_t capacity)
+        {
+            if (capacity <= m_capacity)
+            {
+                return;
+            }
+
+            // round up to a multiple of the buffer alignment, headroom for alignment padding
+            const std::size_t new_capacity = ((capacity + (capacity >> 3U) + buffer_alignment - 1U) / buffer_alignment)
+                * buffer_alignment;
+            auto* buffer = static_cast<std::byte*>(m_upstream->allocate(new_capacity, buffer_alignment));
+
+            if (nullptr != m_buffer)
+            {
+                m_upstream->deallocate(m_buffer, m_capacity, buffer_alignment);
+            }
+
+            m_buffer = buffer;
+            m_capacity = new_capacity;
+        }
+
+        std::pmr::memory_resource* m_upstream;
+        std::byte* m_buffer = nullptr;
+        std::size_t m_capacity = 0U;
+        std::size_t m_offset = 0U;
+        overflow_block* m_overflow = nullptr;
+        std::size_t m_overflow_bytes = 0U;
+        std::size_t m_high_water_mark = 0U;
+        std::uint64_t m_overflow_allocations = 0U;
+    };
+
+    /**
+     * @brief STL allocator drawing from a frame_arena (deallocate is a no-op).
+     *
+     * @tparam T The type of the allocated elements.
+     */
+    template <typename T>
+    class frame_arena_allocator
+    {
+    public:
+        using value_type = T;
+
+        explicit frame_arena_allocator(frame_arena& arena) noexcept
+            : m_arena { &arena }
+        {
+        }
+
+        template <typename U>
+        frame_arena_allocator(const frame_arena_allocator<U>& other) noexcept // NOLINT implicit rebind conversion
+            : m_arena { other.arena() }
+        {
+        }
+
+        [[nodiscard]] T* allocate(std::size_t count)
+        {
+            if (count > (std::numeric_limits<std::size_t>::max() / sizeof(T)))
+            {
+                throw std::bad_array_new_length();
+            }
+
+            return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* ptr, std::size_t count) noexcept
+        {
+            (void)ptr;
+            (void)count;
+        }
+
+        [[nodiscard]] frame_arena* arena() const noexcept
+        {
+            return m_arena;
+        }
+
+        template <typename U>
+        bool operator==(const frame_arena_allocator<U>& other) const noexcept
+        {
+            return m_arena == other.arena();
+        }
+
+        template <typename U>
+        bool operator!=(const frame_arena_allocator<U>& other) const noexcept
+        {
+            return m_arena != other.arena();
+        }
+
+    private:
+        frame_arena* m_arena;
+    };
+
+    /**
+     * @brief Resets a frame_arena when leaving the scope of a periodic tick.
+     *
+     * Declared at the top of a periodic_task (or periodic_scheduler) routine, before
+     * any container using the arena, so the containers are destroyed before the reset.
+     */
+    class frame_arena_scope : public non_copyable // NOLINT inherits from non copyable/non movable
+    {
+    public:
+        frame_arena_scope() = delete;
+
+        explicit frame_arena_scope(frame_arena& arena) noexcept
+            : m_arena { arena }
+        {
+        }
+
+        ~frame_arena_scope()
+        {
+            m_arena.reset();
+        }
+
+    private:
+        frame_arena& m_arena;
+    };
+}
+
+#endif //  FRAME_ARENA_HPP_
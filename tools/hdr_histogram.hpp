@@ -0,0 +1,300 @@
+/**
+ * @file hdr_histogram.hpp
+ * @brief Fixed-memory log-linear (HDR-style) histogram for latency samples.
+ * @author Laurent Lardinois
+ * @date October 2026
+ */
+
+//-----------------------------------------------------------------------------//
+// C++ Publish/Subscribe Pattern - Spare time development for fun              //
+// (c) 2025-2026 Laurent Lardinois https://be.linkedin.com/in/laurentlardinois //
+//                                                                             //
+// https://github.com/type-one/PublishSubscribe                                //
+//                                                                             //
+// MIT License                                                                 //
+//                                                                             //
+// This software is provided 'as-is', without any express or implied           //
+// warranty.In no event will the authors be held liable for any damages        //
+// arising from the use of this software.                                      //
+//                                                                             //
+// Permission is granted to anyone to use this software for any purpose,       //
+// including commercial applications, and to alter itand redistribute it       //
+// freely, subject to the following restrictions :                             //
+//                                                                             //
+// 1. The origin of this software must not be misrepresented; you must not     //
+// claim that you wrote the original software.If you use this software         //
+// in a product, an acknowledgment in the product documentation would be       //
+// appreciated but is not required.                                            //
+// 2. Altered source versions must be plainly marked as such, and must not be  //
+// misrepresented as being the original software.                              //
+// 3. This notice may not be removed or altered from any source distribution.  //
+//-----------------------------------------------------------------------------//
+
+#pragma once
+
+#if !defined(HDR_HISTOGRAM_HPP_)
+#define HDR_HISTOGRAM_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if (__cplusplus >= 202002L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L))
+#include <bit>
+#endif
+
+namespace tools
+{
+    /**
+     * @brief Log-linear bucketed histogram of unsigned integer values (e.g. latencies in us or ns).
+     *
+     * Values below 2^precision_bits get one bucket each, then every power of 2 range is split
+     * into 2^precision_bits linear sub-buckets, so the relative error of any reported value
+     * stays below 1 / 2^precision_bits. Memory is allocated once at construction.
+     *
+     * record() is O(1) (a bit scan and an increment), percentiles are a cumulative scan over
+     * the buckets and histograms with the same layout merge losslessly.
+     */
+    class hdr_histogram
+    {
+    public:
+        static constexpr int default_precision_bits = 7; // relative error below 1/128 (0.8%)
+        static constexpr int max_precision_bits = 14;
+        static constexpr std::uint64_t default_highest_trackable_value = 3600000000ULL; // 1 hour in us
+
+        explicit hdr_histogram(std::uint64_t highest_trackable_value = default_highest_trackable_value,
+            int precision_bits = default_precision_bits)
+            : m_precision_bits { std::clamp(precision_bits, 1, max_precision_bits) }
+            , m_sub_bucket_count { 1ULL << static_cast<unsigned>(m_precision_bits) }
+            , m_highest_trackable_value { std::max(highest_trackable_value, m_sub_bucket_count) }
+            , m_counts(bucket_index(m_highest_trackable_value) + 1U, 0U)
+        {
+        }
+
+        ~hdr_histogram() = default;
+
+        hdr_histogram(const hdr_histogram&) = default;
+        hdr_histogram& operator=(const hdr_histogram&) = default;
+        hdr_histogram(hdr_histogram&&) noexcept = default;
+        hdr_histogram& operator=(hdr_histogram&&) noexcept = default;
+
+        /**
+         * @brief Records a value (values above the highest trackable value are clamped).
+         *
+         * @param value The value to record.
+         * @param count Number of occurrences of the value.
+         */
+        void record(std::uint64_t value, std::uint64_t count = 1U) noexcept
+        {
+            if (value > m_highest_trackable_value)
+            {
+                value = m_highest_trackable_value;
+                m_clamped_count += count;
+            }
+
+            m_counts[bucket_index(value)] += count;
+            m_total_count += count;
+            m_sum += static_cast<double>(value) * static_cast<double>(count);
+            m_min = std::min(m_min, value);
+            m_max = std::max(m_max, value);
+        }
+
+        /**
+         * @brief Adds the counts of another histogram with the same layout.
+         *
+         * @param other The histogram to merge.
+         * @return false if the layouts (precision, highest trackable value) differ.
+         */
+        bool merge(const hdr_histogram& other) noexcept
+        {
+            if (!same_layout(other))
+            {
+                return false;
+            }
+
+            for (std::size_t idx = 0U; idx < m_counts.size(); ++idx)
+            {
+                m_counts[idx] += other.m_counts[idx];
+            }
+
+            m_total_count += other.m_total_count;
+            m_clamped_count += other.m_clamped_count;
+            m_sum += other.m_sum;
+            m_min = std::min(m_min, other.m_min);
+            m_max = std::max(m_max, other.m_max);
+
+            return true;
+        }
+
+        void reset() noexcept
+        {
+            std::fill(m_counts.begin(), m_counts.end(), 0U);
+            m_total_count = 0U;
+            m_clamped_count = 0U;
+            m_sum = 0.0;
+            m_min = std::numeric_limits<std::uint64_t>::max();
+            m_max = 0U;
+        }
+
+        /**
+         * @brief Returns the value below or equal to which the given percentage of the samples fall.
+         *
+         * The result is the highest value equivalent to the bucket reaching the percentile,
+         * bounded by the recorded min and max. Returns 0 when empty.
+         *
+         * @param percentile Percentage in [0, 100] (e.g. 50, 99, 99.9).
+         */
+        [[nodiscard]] std::uint64_t percentile(double percentile) const noexcept
+        {
+            if (0U == m_total_count)
+            {
+                return 0U;
+            }
+
+            const double ratio = std::clamp(percentile, 0.0, 100.0) / 100.0;
+            const auto rank = std::max(
+                static_cast<std::uint64_t>(std::ceil(ratio * static_cast<double>(m_total_count))), std::uint64_t { 1U });
+
+            std::uint64_t cumulated = 0U;
+            for (std::size_t idx = 0U; idx < m_counts.size(); ++idx)
+            {
+                cumulated += m_counts[idx];
+                if (cumulated >= rank)
+                {
+                    return std::clamp(bucket_highest_value(idx), m_min, m_max);
+                }
+            }
+
+            return m_max;
+        }
+
+        [[nodiscard]] std::uint64_t total_count() const noexcept
+        {
+            return m_total_count;
+        }
+
+        // samples recorded above the highest trackable value
+        [[nodiscard]] std::uint64_t clamped_count() const noexcept
+        {
+            return m_clamped_count;
+        }
+
+        [[nodiscard]] std::uint64_t min() const noexcept
+        {
+            return (0U == m_total_count) ? 0U : m_min;
+        }
+
+        [[nodiscard]] std::uint64_t max() const noexcept
+        {
+            return m_max;
+        }
+
+        [[nodiscard]] double mean() const noexcept
+        {
+            return (0U == m_total_count) ? 0.0 : (m_sum / static_cast<double>(m_total_count));
+        }
+
+        [[nodiscard]] int precision_bits() const noexcept
+        {
+            return m_precision_bits;
+        }
+
+        [[nodiscard]] std::uint64_t highest_trackable_value() const noexcept
+        {
+            return m_highest_trackable_value;
+        }
+
+        [[nodiscard]] bool same_layout(const hdr_histogram& other) const noexcept
+        {
+            return (m_precision_bits == other.m_precision_bits)
+                && (m_highest_trackable_value == other.m_highest_trackable_value);
+        }
+
+        // bucket level access (dumps, custom merges)
+
+        [[nodiscard]] std::size_t bucket_count() const noexcept
+        {
+            return m_counts.size();
+        }
+
+        [[nodiscard]] std::uint64_t count_at(std::size_t idx) const noexcept
+        {
+            return m_counts[idx];
+        }
+
+        [[nodiscard]] std::size_t bucket_index(std::uint64_t value) const noexcept
+        {
+            if (value < m_sub_bucket_count)
+            {
+                return static_cast<std::size_t>(value);
+            }
+
+            // sub-bucket of the power of 2 range: the precision_bits + 1 leading bits of the value
+            const int shift = bit_width(value) - 1 - m_precision_bits;
+            return static_cast<std::size_t>(
+                (static_cast<std::uint64_t>(shift) << static_cast<unsigned>(m_precision_bits)) + (value >> shift));
+        }
+
+        [[nodiscard]] std::uint64_t bucket_lowest_value(std::size_t idx) const noexcept
+        {
+            const auto index = static_cast<std::uint64_t>(idx);
+            if (index < (m_sub_bucket_count << 1U))
+            {
+                return index;
+            }
+
+            const auto shift = (index >> static_cast<unsigned>(m_precision_bits)) - 1U;
+            const auto mantissa = index - (shift << static_cast<unsigned>(m_precision_bits));
+            return (mantissa << shift);
+        }
+
+        [[nodiscard]] std::uint64_t bucket_highest_value(std::size_t idx) const noexcept
+        {
+            const auto index = static_cast<std::uint64_t>(idx);
+            if (index < (m_sub_bucket_count << 1U))
+            {
+                return index;
+            }
+
+            const auto shift = (index >> static_cast<unsigned>(m_precision_bits)) - 1U;
+            return bucket_lowest_value(idx) + ((1ULL << shift) - 1U);
+        }
+
+    private:
+        friend class concurrent_histogram; // rebuilds snapshots from its shards
+
+        // number of bits needed to represent the value (C++17 fallback: binary search)
+        static constexpr int bit_width(std::uint64_t value) noexcept
+        {
+#if (__cplusplus >= 202002L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L))
+            return static_cast<int>(std::bit_width(value));
+#else
+            int width = 0;
+            for (unsigned step = 32U; step > 0U; step >>= 1U)
+            {
+                if ((value >> step) != 0U)
+                {
+                    value >>= step;
+                    width += static_cast<int>(step);
+                }
+            }
+            return width + ((0U != value) ? 1 : 0);
+#endif
+        }
+
+        int m_precision_bits;
+        std::uint64_t m_sub_bucket_count;
+        std::uint64_t m_highest_trackable_value;
+        std::vector<std::uint64_t> m_counts;
+        std::uint64_t m_total_count = 0U;
+        std::uint64_t m_clamped_count = 0U;
+        double m_sum = 0.0;
+        std::uint64_t m_min = std::numeric_limits<std::uint64_t>::max();
+        std::uint64_t m_max = 0U;
+    };
+}
+
+#endif //  HDR_HISTOGRAM_HPP_
@@ -0,0 +1,236 @@
+/**
+ * @file heavy_hitters.hpp
+ * @brief Bounded-memory heavy hitters (Space-Saving) with top-k queries.
+ * @author Laurent Lardinois
+ * @date October 2026
+ */
+
+//-----------------------------------------------------------------------------//
+// C++ Publish/Subscribe Pattern - Spare time development for fun              //
+// (c) 2025-2026 Laurent Lardinois https://be.linkedin.com/in/laurentlardinois //
+//                                                                             //
+// https://github.com/type-one/PublishSubscribe                                //
+//                                                                             //
+// MIT License                                                                 //
+//                                                                             //
+// This software is provided 'as-is', without any express or implied           //
+// warranty.In no event will the authors be held liable for any damages        //
+// arising from the use of this software.                                      //
+//                                                                             //
+// Permission is granted to anyone to use this software for any purpose,       //
+// including commercial applications, and to alter itand redistribute it       //
+// freely, subject to the following restrictions :                             //
+//                                                                             //
+// 1. The origin of this software must not be misrepresented; you must not     //
+// claim that you wrote the original software.If you use this software         //
+// in a product, an acknowledgment in the product documentation would be       //
+// appreciated but is not required.                                            //
+// 2. Altered source versions must be plainly marked as such, and must not be  //
+// misrepresented as being the original software.                              //
+// 3. This notice may not be removed or altered from any source distribution.  //
+//-----------------------------------------------------------------------------//
+
+#pragma once
+
+#if !defined(HEAVY_HITTERS_HPP_)
+#define HEAVY_HITTERS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "tools/non_copyable.hpp"
+
+namespace tools
+{
+    /**
+     * @brief Estimated frequency of a monitored key.
+     *
+     * The true count lies in [count - error, count].
+     */
+    template <typename Key>
+    struct heavy_hitter
+    {
+        Key key;
+        std::uint64_t count = 0U;
+        std::uint64_t error = 0U;
+    };
+
+    /**
+     * @brief Space-Saving sketch tracking the most frequent keys of a stream in fixed memory.
+     *
+     * Monitors at most `capacity` keys. An unmonitored key replaces the key with the smallest
+     * count and inherits that count as its error, so any key more frequent than
+     * total / capacity is guaranteed to be monitored. Updates are O(log capacity) through an
+     * indexed min-heap, and evictions reuse the index nodes (no allocation once full).
+     *
+     * @tparam Key The type of the keys (e.g. topic names, publisher ids).
+     * @tparam Hash Hash function of the keys.
+     */
+    template <typename Key, typename Hash = std::hash<Key>>
+    class heavy_hitters : public non_copyable // NOLINT inherits from non copyable and non movable class
+    {
+    public:
+        struct thread_safe
+        {
+            static constexpr bool value = false;
+        };
+
+        heavy_hitters() = delete;
+
+        explicit heavy_hitters(std::size_t capacity)
+            : m_capacity { std::max<std::size_t>(capacity, 1U) }
+        {
+            m_heap.reserve(m_capacity);
+            m_index.reserve(m_capacity);
+        }
+
+        ~heavy_hitters() = default;
+
+        /**
+         * @brief Counts an occurrence of a key.
+         *
+         * @param key The key.
+         * @param weight Number of occurrences.
+         */
+        void add(const Key& key, std::uint64_t weight = 1U)
+        {
+            m_total += weight;
+
+            if (auto found = m_index.find(key); found != m_index.end())
+            {
+                m_heap[found->second].count += weight;
+                sift_down(found->second);
+                return;
+            }
+
+            if (m_heap.size() < m_capacity)
+            {
+                m_heap.push_back(heavy_hitter<Key> { key, weight, 0U });
+                m_index.emplace(key, m_heap.size() - 1U);
+                sift_up(m_heap.size() - 1U);
+                return;
+            }
+
+            // replace the least frequent key, reusing its index node
+            auto& minimum = m_heap.front();
+            auto node = m_index.extract(minimum.key);
+            node.key() = key;
+            m_index.insert(std::move(node));
+
+            minimum.key = key;
+            minimum.error = minimum.count;
+            minimum.count += weight;
+            sift_down(0U);
+        }
+
+        /**
+         * @brief Returns the k most frequent monitored keys, by decreasing estimated count.
+         */
+        [[nodiscard]] std::vector<heavy_hitter<Key>> top(std::size_t k) const
+        {
+            std::vector<heavy_hitter<Key>> result(m_heap.begin(), m_heap.end());
+            k = std::min(k, result.size());
+
+            std::partial_sort(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(k), result.end(),
+                [](const heavy_hitter<Key>& lhs, const heavy_hitter<Key>& rhs) { return lhs.count > rhs.count; });
+            result.resize(k);
+
+            return result;
+        }
+
+        /**
+         * @brief Returns the estimated count of a key (0 if not monitored).
+         */
+        [[nodiscard]] std::uint64_t estimate(const Key& key) const
+        {
+            const auto found = m_index.find(key);
+            return (found != m_index.end()) ? m_heap[found->second].count : 0U;
+        }
+
+        // total weight of the stream
+        [[nodiscard]] std::uint64_t total() const
+        {
+            return m_total;
+        }
+
+        [[nodiscard]] std::size_t capacity() const
+        {
+            return m_capacity;
+        }
+
+        // number of monitored keys
+        [[nodiscard]] std::size_t size() const
+        {
+            return m_heap.size();
+        }
+
+        void clear()
+        {
+            m_heap.clear();
+            m_index.clear();
+            m_total = 0U;
+        }
+
+    private:
+        void swap_entries(std::size_t lhs, std::size_t rhs)
+        {
+            std::swap(m_heap[lhs], m_heap[rhs]);
+            m_index[m_heap[lhs].key] = lhs;
+            m_index[m_heap[rhs].key] = rhs;
+        }
+
+        void sift_up(std::size_t pos)
+        {
+            while (pos > 0U)
+            {
+                const std::size_t parent = (pos - 1U) >> 1U;
+                if (m_heap[parent].count <= m_heap[pos].count)
+                {
+                    break;
+                }
+                swap_entries(parent, pos);
+                pos = parent;
+            }
+        }
+
+        void sift_down(std::size_t pos)
+        {
+            const std::size_t size = m_heap.size();
+
+            for (;;)
+            {
+                const std::size_t left = (pos << 1U) + 1U;
+                const std::size_t right = left + 1U;
+                std::size_t smallest = pos;
+
+                if ((left < size) && (m_heap[left].count < m_heap[smallest].count))
+                {
+                    smallest = left;
+                }
+                if ((right < size) && (m_heap[right].count < m_heap[smallest].count))
+                {
+                    smallest = right;
+                }
+                if (smallest == pos)
+                {
+                    break;
+                }
+
+                swap_entries(pos, smallest);
+                pos = smallest;
+            }
+        }
+
+        std::size_t m_capacity;
+        std::vector<heavy_hitter<Key>> m_heap;              // min-heap on count
+        std::unordered_map<Key, std::size_t, Hash> m_index; // key -> position in the heap
+        std::uint64_t m_total = 0U;
+    };
+}
+
+#endif //  HEAVY_HITTERS_HPP_
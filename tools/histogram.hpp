@@ -4,7 +4,7 @@
  *
  * This file contains the definition of the histogram class template, which provides
  * functionality for adding values, calculating statistical measures such as average,
- * variance, median, and computing Gaussian probability.
+ * variance, skewness, kurtosis (running moments), median, and computing Gaussian probability.
  *
  * @author Laurent Lardinois
  * @date January 2025
@@ -41,7 +41,10 @@
 #define HISTOGRAM_HPP_
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <numeric>
 #include <random>
 #include <type_traits>
 #include <unordered_map>
@@ -50,6 +53,7 @@
 
 #if (__cplusplus >= 202002L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L))
 #include <ranges>
+#include <span>
 #endif
 
 #include "tools/non_copyable.hpp"
@@ -63,6 +67,9 @@ namespace tools
     /**
      * @brief A class representing a histogram for counting occurrences of values.
      *
+     * Running moments, median and Gaussian helpers are only available for arithmetic types,
+     * other hashable types (e.g. std::string) are limited to occurrence counting.
+     *
      * @tparam T The type of values stored in the histogram.
      */
     template <typename T>
@@ -139,6 +146,74 @@ namespace tools
         }
 #endif
 
+        /**
+         * @brief Bulk insertion of a contiguous array of values.
+         *
+         * The moments of the batch are computed with branch-free reductions (auto-vectorized
+         * in optimized builds) and combined once with the running moments, instead of one
+         * Welford update (with a division) per value. Runs of identical consecutive values
+         * (e.g. quantized signals) cost a single hash lookup.
+         *
+         * @param values Pointer to the first value.
+         * @param count Number of values.
+         * @return The number of values added.
+         */
+        std::size_t add_bulk(const T* values, std::size_t count)
+        {
+            if (0U == count)
+            {
+                return 0U;
+            }
+
+            if constexpr (std::is_arithmetic_v<T>)
+            {
+                // batch moments (two passes: mean, then centered sums of powers)
+                double sum = 0.0;
+                for (std::size_t i = 0U; i < count; ++i)
+                {
+                    sum += static_cast<double>(values[i]);
+                }
+                const double batch_mean = sum / static_cast<double>(count);
+
+                double batch_m2 = 0.0;
+                double batch_m3 = 0.0;
+                double batch_m4 = 0.0;
+                for (std::size_t i = 0U; i < count; ++i)
+                {
+                    const double delta = static_cast<double>(values[i]) - batch_mean;
+                    const double delta2 = delta * delta;
+                    batch_m2 += delta2;
+                    batch_m3 += delta2 * delta;
+                    batch_m4 += delta2 * delta2;
+                }
+
+                merge_moments(count, batch_mean, batch_m2, batch_m3, batch_m4);
+            }
+            else
+            {
+                m_total_count += static_cast<int>(count);
+            }
+
+            // binning: one hash lookup per run of identical consecutive values
+            const T* const last = values + count;
+            for (const T* run = values; run != last;)
+            {
+                const T* run_end = std::find_if(run, last, [run](const T& value) { return !(value == *run); });
+                add_occurences(*run, static_cast<int>(run_end - run));
+                run = run_end;
+            }
+
+            return count;
+        }
+
+#if (__cplusplus >= 202002L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L))
+        // C++20: span overload of the bulk insertion
+        std::size_t add_bulk(std::span<const T> values)
+        {
+            return add_bulk(values.data(), values.size());
+        }
+#endif
+
         /**
          * @brief Returns the top value of the histogram.
          *
@@ -170,55 +245,84 @@ namespace tools
         }
 
         /**
-         * @brief Calculates the average value of the histogram.
+         * @brief Returns the average value of the histogram.
          *
-         * This function computes the average value of the histogram by summing up the
-         * products of occurrences and their corresponding values, and then dividing
-         * by the total number of occurrences.
+         * The mean is maintained incrementally by add (Welford), so this is an O(1) query.
          *
-         * @return The average value of the histogram as type T. If there are no
-         * occurrences, it returns 0.
+         * @return The average value of the histogram. If there are no occurrences, it returns 0.
          */
         [[nodiscard]] double average() const
         {
-            double avg = 0.0;
-            const auto total = static_cast<double>(m_total_count);
+            return (m_total_count > 0) ? m_mean : 0.0;
+        }
 
-            for (auto itr = m_occurences.cbegin(); itr != m_occurences.cend(); ++itr)
+        /**
+         * @brief Returns the (population) variance of the data set in O(1).
+         *
+         * @return The variance of the data set, 0 if there are no occurrences.
+         */
+        [[nodiscard]] double variance() const
+        {
+            return (m_total_count > 0) ? (m_m2 / static_cast<double>(m_total_count)) : 0.0;
+        }
+
+        /**
+         * @brief Calculates the mean squared deviation of the data set around a given value.
+         *
+         * Derived in O(1) from the running moments: variance + (mean - average)^2, which is
+         * the variance itself when given the average of the data set.
+         *
+         * @param average The reference value (usually the average of the data set).
+         * @return The mean squared deviation around the given value.
+         */
+        [[nodiscard]] double variance(double average) const
+        {
+            // https://www.calculatorsoup.com/calculators/statistics/standard-deviation-calculator.php
+            if (0 == m_total_count)
             {
-                if (itr->second > 0) // occurence
-                {
-                    avg += static_cast<double>(itr->second * itr->first);
-                }
+                return 0.0;
             }
 
-            return (total > 0.0) ? (avg / total) : 0.0;
+            const double shift = m_mean - average;
+            return variance() + (shift * shift);
         }
 
         /**
-         * @brief Calculates the variance of the data set.
-         *
-         * This function computes the variance of the data set stored in the histogram.
+         * @brief Returns the standard deviation of the data set in O(1).
+         */
+        [[nodiscard]] double standard_deviation() const
+        {
+            return std::sqrt(variance());
+        }
+
+        /**
+         * @brief Returns the skewness (third standardized moment) of the data set in O(1).
          *
-         * @param average The average value of the data set.
-         * @return The variance of the data set.
+         * @return 0 if the data set has no spread.
          */
-        [[nodiscard]] double variance(double average) const
+        [[nodiscard]] double skewness() const
         {
-            double vari = 0.0;
-            const auto total = static_cast<double>(m_total_count);
+            if (m_m2 <= 0.0)
+            {
+                return 0.0;
+            }
 
-            for (auto itr = m_occurences.cbegin(); itr != m_occurences.cend(); ++itr)
+            return (std::sqrt(static_cast<double>(m_total_count)) * m_m3) / std::pow(m_m2, 1.5); // NOLINT math formula
+        }
+
+        /**
+         * @brief Returns the excess kurtosis (fourth standardized moment - 3) of the data set in O(1).
+         *
+         * @return 0 if the data set has no spread.
+         */
+        [[nodiscard]] double kurtosis() const
+        {
+            if (m_m2 <= 0.0)
             {
-                if (itr->second > 0) // occurence
-                {
-                    // https://www.calculatorsoup.com/calculators/statistics/standard-deviation-calculator.php
-                    const auto dva = static_cast<double>(itr->first) - average;
-                    vari += itr->second * (dva * dva);
-                }
+                return 0.0;
             }
 
-            return (total > 0.0) ? (vari / total) : 0.0;
+            return ((static_cast<double>(m_total_count) * m_m4) / (m_m2 * m_m2)) - 3.0; // NOLINT math formula
         }
 
         /**
@@ -244,6 +348,8 @@ namespace tools
          */
         [[nodiscard]] double median() const
         {
+            static_assert(std::is_arithmetic_v<T>, "requires an arithmetic value type");
+
             std::vector<T> to_sort;
 
             for (auto itr = m_occurences.cbegin(); itr != m_occurences.cend(); ++itr)
@@ -293,6 +399,8 @@ namespace tools
          */
         double gaussian_density(T value, double average, double standard_deviation) const // NOLINT keep it
         {
+            static_assert(std::is_arithmetic_v<T>, "requires an arithmetic value type");
+
             // https://fr.wikipedia.org/wiki/Loi_normale
             // https://www.savarese.org/math/gaussianintegral.html
             double result = 0.0;
@@ -307,6 +415,80 @@ namespace tools
             return result;
         }
 
+        /**
+         * @brief Computes the Gaussian density of an array of values.
+         *
+         * Same formula as gaussian_density with the constants hoisted out of a branch-free
+         * loop, auto-vectorized in optimized builds.
+         *
+         * @param values Pointer to the first value.
+         * @param count Number of values.
+         * @param densities Output array of count densities.
+         * @param average The mean (average) of the Gaussian distribution.
+         * @param standard_deviation The standard deviation (sigma) of the Gaussian distribution.
+         */
+        void gaussian_density_batch(
+            const T* values, std::size_t count, double* densities, double average, double standard_deviation) const
+        {
+            static_assert(std::is_arithmetic_v<T>, "requires an arithmetic value type");
+
+            if (standard_deviation <= 0.0)
+            {
+                std::fill(densities, densities + count, 0.0);
+                return;
+            }
+
+            static const double sqrt_two_pi = std::sqrt(M_TWO_PI);
+            const double inv_sigma = 1.0 / standard_deviation;
+            const double norm = inv_sigma / sqrt_two_pi;
+
+            for (std::size_t i = 0U; i < count; ++i)
+            {
+                const double epsilon = (static_cast<double>(values[i]) - average) * inv_sigma;
+                densities[i] = norm * std::exp(-0.5 * epsilon * epsilon); // NOLINT math formula
+            }
+        }
+
+#if (__cplusplus >= 202002L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L))
+        // C++20: span overload (densities must hold at least values.size() elements)
+        void gaussian_density_batch(
+            std::span<const T> values, std::span<double> densities, double average, double standard_deviation) const
+        {
+            gaussian_density_batch(values.data(), std::min(values.size(), densities.size()), densities.data(), average,
+                standard_deviation);
+        }
+#endif
+
+        /**
+         * @brief Computes the exact Gaussian probability over a range with the error function.
+         *
+         * Closed form of the integral estimated by gaussian_probability:
+         * 0.5 * (erf((to - average) / (sigma * sqrt(2))) - erf((from - average) / (sigma * sqrt(2)))).
+         *
+         * @param range_from The lower bound of the range.
+         * @param range_to The upper bound of the range.
+         * @param average The mean (average) of the Gaussian distribution.
+         * @param standard_deviation The standard deviation of the Gaussian distribution.
+         * @return The probability that a value falls within the specified range.
+         */
+        double gaussian_interval_probability(T range_from, T range_to, double average, double standard_deviation) const
+        {
+            static_assert(std::is_arithmetic_v<T>, "requires an arithmetic value type");
+
+            // https://en.wikipedia.org/wiki/Normal_distribution#Cumulative_distribution_function
+            if (standard_deviation <= 0.0)
+            {
+                return 0.0;
+            }
+
+            static const double inv_sqrt_two = 1.0 / std::sqrt(2.0);
+            const double scale = inv_sqrt_two / standard_deviation;
+            const double upper = std::erf((static_cast<double>(range_to) - average) * scale);
+            const double lower = std::erf((static_cast<double>(range_from) - average) * scale);
+
+            return 0.5 * (upper - lower); // NOLINT math formula
+        }
+
         /**
          * @brief Calculates the Gaussian probability over a specified range using Monte Carlo integration.
          *
@@ -325,6 +507,8 @@ namespace tools
         double gaussian_probability(
             T range_from, T range_to, double average, double standard_deviation, int montecarlo_samples) const
         {
+            static_assert(std::is_arithmetic_v<T>, "requires an arithmetic value type");
+
             // https://cameron-mcelfresh.medium.com/monte-carlo-integration-313b37157852
             // https://www.savarese.org/math/gaussianintegral.html
             // https://en.wikipedia.org/wiki/Gaussian_integral
@@ -332,26 +516,26 @@ namespace tools
             double result = 0.0;
             if ((standard_deviation > 0.0) && (montecarlo_samples > 0))
             {
-                std::random_device rand_dev;
-                std::mt19937 generator(rand_dev());
+                // seeded once per thread instead of once per call
+                static thread_local std::mt19937 generator(std::random_device {}());
 
-                if constexpr (std::is_integral<T>::value)
-                {
-                    std::uniform_int_distribution<T> distr(range_from, range_to);
-                    for (int i = 0; i < montecarlo_samples; ++i)
-                    {
-                        const T value = distr(generator);
-                        result += gaussian_density(value, average, standard_deviation);
-                    }
-                }
-                else
+                // draw the samples by batches and evaluate them with the batch density kernel
+                constexpr std::size_t batch_size = 256U;
+                std::array<T, batch_size> values = {};
+                std::array<double, batch_size> densities = {};
+
+                using distribution = std::conditional_t<std::is_integral<T>::value, std::uniform_int_distribution<T>,
+                    std::uniform_real_distribution<T>>;
+                distribution distr(range_from, range_to);
+
+                auto remaining = static_cast<std::size_t>(montecarlo_samples);
+                while (remaining > 0U)
                 {
-                    std::uniform_real_distribution<T> distr(range_from, range_to);
-                    for (int i = 0; i < montecarlo_samples; ++i)
-                    {
-                        const T value = distr(generator);
-                        result += gaussian_density(value, average, standard_deviation);
-                    }
+                    const std::size_t batch = std::min(remaining, batch_size);
+                    std::generate_n(values.begin(), batch, [&distr]() { return distr(generator); });
+                    gaussian_density_batch(values.data(), batch, densities.data(), average, standard_deviation);
+                    result = std::accumulate(densities.cbegin(), densities.cbegin() + batch, result);
+                    remaining -= batch;
                 }
 
                 result = (result * static_cast<double>(range_to - range_from))
@@ -378,13 +562,90 @@ namespace tools
                 m_top_value = found->first;
             }
 
+            if constexpr (std::is_arithmetic_v<T>)
+            {
+                update_moments(static_cast<double>(found->first));
+            }
+            else
+            {
+                // no moments for non-arithmetic keys (e.g. std::string), only occurrences are tracked
+                ++m_total_count;
+            }
+        }
+
+        // bulk counterpart of add_impl for a run of identical values
+        void add_occurences(const T& value, int occurences)
+        {
+            auto [found, inserted] = m_occurences.try_emplace(value, occurences);
+
+            if (!inserted)
+            {
+                found->second += occurences;
+            }
+
+            if ((0 == m_top_occurence) || (found->second > m_top_occurence))
+            {
+                m_top_occurence = found->second;
+                m_top_value = found->first;
+            }
+        }
+
+        // combine the moments of a batch with the running moments (Chan/Pebay pairwise update)
+        // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Parallel_algorithm
+        void merge_moments(
+            std::size_t batch_count, double batch_mean, double batch_m2, double batch_m3, double batch_m4)
+        {
+            const auto count_a = static_cast<double>(m_total_count);
+            const auto count_b = static_cast<double>(batch_count);
+            const double count = count_a + count_b;
+
+            const double delta = batch_mean - m_mean;
+            const double delta2 = delta * delta;
+            const double ab = count_a * count_b;
+
+            const double m2 = m_m2 + batch_m2 + ((delta2 * ab) / count);
+            const double m3 = m_m3 + batch_m3 + ((delta2 * delta * ab * (count_a - count_b)) / (count * count))
+                + ((3.0 * delta * ((count_a * batch_m2) - (count_b * m_m2))) / count); // NOLINT math formula
+            const double m4 = m_m4 + batch_m4
+                + ((delta2 * delta2 * ab * ((count_a * count_a) - ab + (count_b * count_b))) / (count * count * count))
+                + ((6.0 * delta2 * ((count_a * count_a * batch_m2) + (count_b * count_b * m_m2))) / (count * count))
+                + ((4.0 * delta * ((count_a * batch_m3) - (count_b * m_m3))) / count); // NOLINT math formula
+
+            m_mean += (delta * count_b) / count;
+            m_m2 = m2;
+            m_m3 = m3;
+            m_m4 = m4;
+            m_total_count += static_cast<int>(batch_count);
+        }
+
+        // Welford/Terriberry running moments: mean and centered sums of powers 2, 3 and 4
+        // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Higher-order_statistics
+        void update_moments(double value)
+        {
+            const auto previous_count = static_cast<double>(m_total_count);
             ++m_total_count;
+            const auto count = static_cast<double>(m_total_count);
+
+            const double delta = value - m_mean;
+            const double delta_n = delta / count;
+            const double delta_n2 = delta_n * delta_n;
+            const double term = delta * delta_n * previous_count;
+
+            m_mean += delta_n;
+            m_m4 += (term * delta_n2 * ((count * count) - (3.0 * count) + 3.0)) // NOLINT math formula
+                + (6.0 * delta_n2 * m_m2) - (4.0 * delta_n * m_m3);            // NOLINT math formula
+            m_m3 += (term * delta_n * (count - 2.0)) - (3.0 * delta_n * m_m2);  // NOLINT math formula
+            m_m2 += term;
         }
 
         std::unordered_map<T, int> m_occurences;
         int m_total_count = 0;
         int m_top_occurence = 0;
-        T m_top_value = static_cast<T>(0);
+        double m_mean = 0.0;
+        double m_m2 = 0.0;
+        double m_m3 = 0.0;
+        double m_m4 = 0.0;
+        T m_top_value {};
     };
 }
 
@@ -0,0 +1,325 @@
+/**
+ * @file linux_realtime_profile.hpp
+ * @brief Real-time profile (scheduling policy, memory locking and prefaulting) applied to the calling thread.
+ *
+ * This file contains the realtime_profile and realtime_report structures and the apply_realtime_profile
+ * function. On Linux it tries SCHED_DEADLINE with an explicit runtime/deadline/period budget and falls back
+ * to SCHED_FIFO or SCHED_RR with a fixed priority, locks the process memory and prefaults stack and heap.
+ * The returned report tells which settings actually took effect.
+ *
+ * @author Laurent Lardinois
+ * @date October 2026
+ */
+
+//-----------------------------------------------------------------------------//
+// C++ Publish/Subscribe Pattern - Spare time development for fun              //
+// (c) 2025-2026 Laurent Lardinois https://be.linkedin.com/in/laurentlardinois //
+//                                                                             //
+// https://github.com/type-one/PublishSubscribe                                //
+//                                                                             //
+// MIT License                                                                 //
+//                                                                             //
+// This software is provided 'as-is', without any express or implied           //
+// warranty.In no event will the authors be held liable for any damages        //
+// arising from the use of this software.                                      //
+//                                                                             //
+// Permission is granted to anyone to use this software for any purpose,       //
+// including commercial applications, and to alter itand redistribute it       //
+// freely, subject to the following restrictions :                             //
+//                                                                             //
+// 1. The origin of this software must not be misrepresented; you must not     //
+// claim that you wrote the original software.If you use this software         //
+// in a product, an acknowledgment in the product documentation would be       //
+// appreciated but is not required.                                            //
+// 2. Altered source versions must be plainly marked as such, and must not be  //
+// misrepresented as being the original software.                              //
+// 3. This notice may not be removed or altered from any source distribution.  //
+//-----------------------------------------------------------------------------//
+
+#pragma once
+
+#if !defined(LINUX_REALTIME_PROFILE_HPP_)
+#define LINUX_REALTIME_PROFILE_HPP_
+
+#include <chrono>
+#include <cstddef>
+
+#if defined(__linux__)
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <alloca.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "tools/linux/linux_sched_deadline.hpp"
+#endif
+
+namespace tools
+{
+    enum class realtime_policy
+    {
+        none,        // default time-sharing scheduling
+        deadline,    // SCHED_DEADLINE
+        fifo,        // SCHED_FIFO
+        round_robin, // SCHED_RR
+        idle         // SCHED_IDLE (background work running only when the CPU is otherwise idle)
+    };
+
+    /**
+     * @brief Requested real-time settings for a thread.
+     *
+     * The SCHED_DEADLINE budget must satisfy runtime <= deadline <= period. When the
+     * deadline policy is not requested, not available or refused, the fallback policy
+     * is applied with the given priority (clamped to the valid range of the policy).
+     */
+    struct realtime_profile
+    {
+        bool use_deadline = true;
+        std::chrono::microseconds runtime = {};
+        std::chrono::microseconds deadline = {};
+        std::chrono::microseconds period = {};
+
+        realtime_policy fallback_policy = realtime_policy::fifo;
+        int fallback_priority = 10;
+
+        bool lock_memory = false;             // mlockall(MCL_CURRENT | MCL_FUTURE)
+        std::size_t prefault_stack_size = 0U; // bytes of stack to touch (clamped to the free stack of the thread)
+        std::size_t prefault_heap_size = 0U;  // bytes of heap to touch, needs pin_heap (ignored otherwise)
+
+        // glibc only: mallopt(M_TRIM_THRESHOLD, -1) and mallopt(M_MMAP_MAX, 0) so freed memory (including the
+        // prefaulted heap) stays in the heap and is never served by mmap. These settings are process wide.
+        // Without them the prefaulted area would be unmapped or trimmed as soon as it is freed.
+        bool pin_heap = false;
+    };
+
+    /**
+     * @brief Settings that actually took effect after applying a @ref realtime_profile.
+     */
+    struct realtime_report
+    {
+        realtime_policy applied_policy = realtime_policy::none;
+        int applied_priority = 0;
+        bool memory_locked = false;
+        std::size_t prefaulted_stack_size = 0U;
+        std::size_t prefaulted_heap_size = 0U; // 0 unless the heap was pinned
+        bool heap_pinned = false; // the process wide mallopt settings of realtime_profile::pin_heap were applied
+        int deadline_error = 0; // errno of the SCHED_DEADLINE attempt (0 if not attempted or successful)
+        int fallback_error = 0; // errno of the fallback policy attempt
+        int memory_error = 0;   // errno of mlockall
+    };
+
+#if defined(__linux__)
+
+    namespace linux_os
+    {
+        inline std::size_t page_size()
+        {
+            const long size = sysconf(_SC_PAGESIZE);
+            return (size > 0) ? static_cast<std::size_t>(size) : 4096U;
+        }
+
+        // stack kept untouched below the prefaulted area for the frames called from here
+        inline constexpr std::size_t prefault_stack_margin = 64U * 1024U;
+
+        // bytes between the current frame and the end of the stack of the calling thread, 0 if unknown
+        __attribute__((noinline)) inline std::size_t free_stack_size()
+        {
+            pthread_attr_t attr;
+            if (0 != pthread_getattr_np(pthread_self(), &attr))
+            {
+                return 0U;
+            }
+
+            void* stack_addr = nullptr;
+            std::size_t stack_size = 0U;
+            const int ret = pthread_attr_getstack(&attr, &stack_addr, &stack_size);
+            pthread_attr_destroy(&attr);
+            if (0 != ret)
+            {
+                return 0U;
+            }
+
+            // the stack grows down from stack_addr + stack_size to stack_addr
+            unsigned char marker = 0U;
+            const auto current = reinterpret_cast<std::uintptr_t>(&marker);
+            const auto lowest = reinterpret_cast<std::uintptr_t>(stack_addr);
+            return ((current > lowest) && (current - lowest <= stack_size)) ? (current - lowest) : 0U;
+        }
+
+        // touch each page of a stack area so later page faults do not happen in the periodic loop
+        __attribute__((noinline)) inline std::size_t prefault_stack(std::size_t size)
+        {
+            const std::size_t free_size = free_stack_size();
+            size = (free_size > prefault_stack_margin) ? std::min(size, free_size - prefault_stack_margin) : 0U;
+            if (0U == size)
+            {
+                return 0U;
+            }
+
+            auto* area = static_cast<volatile unsigned char*>(alloca(size));
+            const std::size_t step = page_size();
+            for (std::size_t offset = 0U; offset < size; offset += step)
+            {
+                area[offset] = 0U;
+            }
+
+            return size;
+        }
+
+        inline std::size_t prefault_heap(std::size_t size)
+        {
+            if (0U == size)
+            {
+                return 0U;
+            }
+
+            // the touched pages stay in the process only once the heap is pinned (see pin_heap)
+            auto* area = static_cast<unsigned char*>(std::malloc(size));
+            if (nullptr == area)
+            {
+                return 0U;
+            }
+
+            const std::size_t step = page_size();
+            for (std::size_t offset = 0U; offset < size; offset += step)
+            {
+                area[offset] = 0U;
+            }
+
+            std::free(area);
+
+            return size;
+        }
+
+        // keep released memory in the process heap and never serve it with mmap (process wide)
+        inline bool pin_heap()
+        {
+#if defined(__GLIBC__)
+            const bool trim_disabled = (0 != mallopt(M_TRIM_THRESHOLD, -1));
+            const bool mmap_disabled = (0 != mallopt(M_MMAP_MAX, 0));
+            return trim_disabled && mmap_disabled;
+#else
+            return false;
+#endif
+        }
+
+        inline int to_posix_policy(realtime_policy policy)
+        {
+            switch (policy)
+            {
+                case realtime_policy::round_robin:
+                    return SCHED_RR;
+                case realtime_policy::idle:
+                    return SCHED_IDLE;
+                case realtime_policy::fifo:
+                default:
+                    return SCHED_FIFO;
+            }
+        }
+    }
+
+    /**
+     * @brief Applies a real-time profile to the calling thread.
+     *
+     * No root check is done: the kernel decides (root, CAP_SYS_NICE or RLIMIT_RTPRIO).
+     *
+     * @param profile Requested settings.
+     * @return The settings that actually took effect.
+     */
+    inline realtime_report apply_realtime_profile(const realtime_profile& profile)
+    {
+        realtime_report report;
+
+        if (profile.lock_memory)
+        {
+            if (0 == mlockall(MCL_CURRENT | MCL_FUTURE))
+            {
+                report.memory_locked = true;
+            }
+            else
+            {
+                report.memory_error = errno;
+            }
+        }
+
+        if (profile.pin_heap)
+        {
+            report.heap_pinned = linux_os::pin_heap();
+        }
+
+        if (report.heap_pinned)
+        {
+            report.prefaulted_heap_size = linux_os::prefault_heap(profile.prefault_heap_size);
+        }
+        report.prefaulted_stack_size = linux_os::prefault_stack(profile.prefault_stack_size);
+
+        if (profile.use_deadline)
+        {
+            const auto tid = static_cast<pid_t>(syscall(SYS_gettid));
+
+            tools::linux_os::sched_attr attr = {};
+            attr.size = sizeof(attr);
+            attr.sched_policy = SCHED_DEADLINE;
+            attr.sched_runtime
+                = static_cast<std::uint64_t>(profile.runtime.count()) * linux_os::sched_deadline_nanosecond_coeff;
+            attr.sched_deadline
+                = static_cast<std::uint64_t>(profile.deadline.count()) * linux_os::sched_deadline_nanosecond_coeff;
+            attr.sched_period
+                = static_cast<std::uint64_t>(profile.period.count()) * linux_os::sched_deadline_nanosecond_coeff;
+
+            if (linux_os::sched_setattr(tid, &attr, 0U) >= 0)
+            {
+                report.applied_policy = realtime_policy::deadline;
+                return report;
+            }
+
+            report.deadline_error = errno;
+        }
+
+        if (realtime_policy::none != profile.fallback_policy)
+        {
+            const int posix_policy = linux_os::to_posix_policy(profile.fallback_policy);
+
+            sched_param param = {};
+            param.sched_priority = std::clamp(profile.fallback_priority, sched_get_priority_min(posix_policy),
+                sched_get_priority_max(posix_policy));
+
+            const int ret = pthread_setschedparam(pthread_self(), posix_policy, &param);
+            if (0 == ret)
+            {
+                report.applied_policy = profile.fallback_policy;
+                report.applied_priority = param.sched_priority;
+            }
+            else
+            {
+                report.fallback_error = ret;
+            }
+        }
+
+        return report;
+    }
+
+#else // end if #defined __linux__
+
+    inline realtime_report apply_realtime_profile(const realtime_profile& profile)
+    {
+        // not implemented
+        (void)profile;
+        return realtime_report {};
+    }
+
+#endif
+}
+
+#endif // LINUX_REALTIME_PROFILE_HPP_
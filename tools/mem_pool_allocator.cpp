@@ -1,6 +1,6 @@
 /**
  * @file mem_pool_allocator.cpp
- * @brief Custom mem pool allocator (caching/reusing) overriding the global new/delete
+ * @brief Custom mem pool allocator (caching/reusing), optionally overriding the global new/delete
  * @author Laurent Lardinois
  * @date March 2026
  */
@@ -30,23 +30,27 @@
 // 3. This notice may not be removed or altered from any source distribution.  //
 //-----------------------------------------------------------------------------//
 
-#if defined(USE_MEM_POOL_ALLOCATOR)
-
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <exception>
 #include <iostream>
 #include <mutex>
 #include <new>
 #include <numeric>
+#include <ostream>
+#include <utility>
 
-#if (__cplusplus >= 202002L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L))
-#include <bit>
+#if defined(_WIN32)
+#include <malloc.h>
+#else
+#include <sys/mman.h>
 #endif
 
-#include "tools/lock_free_ring_buffer.hpp"
+#include "tools/mem_pool_allocator.hpp"
 
 namespace
 {
@@ -57,160 +61,1122 @@ namespace
     // We cache and reuse small blocks of memory to prevent memory fragmentation
     // with small frequent events messages.
     //
-    // The structure relies on lock free ring buffers and a pair of writer/reader mutexes
-    // for the situation where multiple writers or multiple readers request the same size of block
+    // Blocks of each size class are carved out of large contiguous slab chunks
+    // (mmap'd and aligned on their size, optionally backed by huge pages), so they stay
+    // dense and cache-friendly. Released blocks go back to an intrusive free list per
+    // size class (the depot), organized as a stack of batches protected by a mutex.
+    //
+    // A background trim pass (see tools::trim_mem_pool) keeps per size class a target
+    // equal to the peak of blocks out of the depot since the previous pass, decaying
+    // by 25% per pass when the demand drops. Slab chunks whose blocks are all free and
+    // beyond the target are unmapped, so idle periods do not pin memory while bursts
+    // keep being served by the retained blocks.
+    //
+    // A page map (two-level radix tree indexed by chunk address) gives the size class
+    // of any slab block in O(1), so unsized and aligned deletes recycle blocks too.
     //
-    // The idea is to allocate and cache only blocks with a power of 2 granularity
-    // (typically from 16-bytes to 512-bytes or 1024-bytes).
+    // Each thread keeps a small magazine (stack of blocks) per size class in front of
+    // the depot, so the common new/delete path is thread-local and lock-free.
+    // Magazines are refilled from / flushed to the depot in batches, one lock
+    // acquisition and O(1) list operation per batch.
+    //
+    // Size classes are spaced every 16 bytes up to 128 bytes, then geometrically with
+    // 4 classes per doubling (160, 192, 224, 256, 320, ...) up to 32 KB, which bounds
+    // the internal fragmentation to 25% while keeping the number of classes small.
+    // A constexpr table maps a requested size to its class in O(1).
     //
     // Blocks that are greater will not be cached as we make the hypothesis
     // that big chunks of memory will be pre-allocated and reused in dedicated pools
     // if necessary.
 
-    constexpr int MIN_CACHED_BLOCK_POW2_SIZE = 4; // 2^4 = 16 bytes
-    constexpr int MAX_CACHED_BLOCK_POW2_SIZE = 9; // 2^9 = 512 bytes
+    constexpr std::size_t SIZE_CLASS_GRANULARITY = 16U;  // every block size is a multiple of 16 bytes
+    constexpr std::size_t LINEAR_CLASSES_MAX_SIZE = 128U; // linear spacing up to 128 bytes
+    constexpr std::size_t CLASSES_PER_DOUBLING = 4U;      // then geometric spacing
+
+    constexpr std::size_t MIN_CACHED_BLOCK_SIZE = SIZE_CLASS_GRANULARITY;
+    constexpr std::size_t MAX_CACHED_BLOCK_SIZE = 32768U;
+
+    constexpr std::size_t count_size_classes()
+    {
+        std::size_t count = LINEAR_CLASSES_MAX_SIZE / SIZE_CLASS_GRANULARITY;
+        for (std::size_t base = LINEAR_CLASSES_MAX_SIZE; base < MAX_CACHED_BLOCK_SIZE; base <<= 1U)
+        {
+            count += CLASSES_PER_DOUBLING;
+        }
+        return count;
+    }
+
+    constexpr std::size_t NB_SIZE_CLASSES = count_size_classes();
+
+    constexpr std::array<std::size_t, NB_SIZE_CLASSES> make_class_block_sizes()
+    {
+        std::array<std::size_t, NB_SIZE_CLASSES> sizes = {};
+        std::size_t idx = 0U;
+
+        for (std::size_t size = SIZE_CLASS_GRANULARITY; size <= LINEAR_CLASSES_MAX_SIZE;
+             size += SIZE_CLASS_GRANULARITY)
+        {
+            sizes[idx++] = size;
+        }
+
+        for (std::size_t base = LINEAR_CLASSES_MAX_SIZE; base < MAX_CACHED_BLOCK_SIZE; base <<= 1U)
+        {
+            for (std::size_t step = 1U; step <= CLASSES_PER_DOUBLING; ++step)
+            {
+                sizes[idx++] = base + (step * (base / CLASSES_PER_DOUBLING));
+            }
+        }
+
+        return sizes;
+    }
+
+    constexpr std::array<std::size_t, NB_SIZE_CLASSES> CLASS_BLOCK_SIZES = make_class_block_sizes();
+
+    static_assert(CLASS_BLOCK_SIZES[NB_SIZE_CLASSES - 1U] == MAX_CACHED_BLOCK_SIZE, "last size class must be the max");
+
+    // size -> class lookup, indexed by the size rounded up to the granularity
+    constexpr std::size_t SIZE_LOOKUP_ENTRIES = (MAX_CACHED_BLOCK_SIZE / SIZE_CLASS_GRANULARITY) + 1U;
+
+    constexpr std::array<std::uint8_t, SIZE_LOOKUP_ENTRIES> make_size_class_lookup()
+    {
+        std::array<std::uint8_t, SIZE_LOOKUP_ENTRIES> lookup = {};
+        std::size_t idx = 0U;
+
+        for (std::size_t entry = 0U; entry < SIZE_LOOKUP_ENTRIES; ++entry)
+        {
+            while (CLASS_BLOCK_SIZES[idx] < (entry * SIZE_CLASS_GRANULARITY))
+            {
+                ++idx;
+            }
+            lookup[entry] = static_cast<std::uint8_t>(idx);
+        }
+
+        return lookup;
+    }
+
+    constexpr std::array<std::uint8_t, SIZE_LOOKUP_ENTRIES> SIZE_CLASS_LOOKUP = make_size_class_lookup();
+
+    constexpr std::size_t MAGAZINE_CAPACITY = 32U;    // max blocks per thread and per size class
+    constexpr std::size_t MIN_MAGAZINE_CAPACITY = 4U; // for the largest blocks
+    constexpr std::size_t MAGAZINE_BYTES = 16384U;    // bytes cached per thread and per size class
+
+    // magazine capacity per size class (bounded in bytes, so large blocks are not hoarded by every thread)
+    constexpr std::array<std::size_t, NB_SIZE_CLASSES> make_magazine_capacities()
+    {
+        std::array<std::size_t, NB_SIZE_CLASSES> capacities = {};
+        for (std::size_t idx = 0U; idx < NB_SIZE_CLASSES; ++idx)
+        {
+            capacities[idx]
+                = std::clamp(MAGAZINE_BYTES / CLASS_BLOCK_SIZES[idx], MIN_MAGAZINE_CAPACITY, MAGAZINE_CAPACITY);
+        }
+        return capacities;
+    }
+
+    constexpr std::array<std::size_t, NB_SIZE_CLASSES> MAGAZINE_CAPACITIES = make_magazine_capacities();
+
+    constexpr int SLAB_CHUNK_POW2_SIZE = 21;                              // 2^21 = 2 MB (huge page size)
+    constexpr std::size_t SLAB_CHUNK_SIZE = (1U << SLAB_CHUNK_POW2_SIZE); // slab chunks are aligned on their size
+    constexpr std::size_t MAX_SLAB_CHUNKS = 1024U;                        // up to 2 GB of slabs
+
+    constexpr std::size_t WARMUP_BLOCKS_PER_CLASS = 511U;
+    constexpr std::size_t WARMUP_MAX_BLOCK_SIZE = 512U; // only the small event/message classes are warmed up
+
+    constexpr int TRIM_DECAY_SHIFT = 2; // the target decays by 1/4 per trim pass
+
+    // page map: chunk index -> size class, as a two-level radix tree over the virtual address space
+    constexpr int ADDRESS_SPACE_BITS = (sizeof(void*) > 4U) ? 48 : 32;
+    constexpr int PAGE_MAP_BITS = ADDRESS_SPACE_BITS - SLAB_CHUNK_POW2_SIZE;
+    constexpr int PAGE_MAP_LEAF_BITS = (PAGE_MAP_BITS + 1) / 2;
+    constexpr int PAGE_MAP_ROOT_BITS = PAGE_MAP_BITS - PAGE_MAP_LEAF_BITS;
+    constexpr std::size_t PAGE_MAP_LEAF_SIZE = (1U << PAGE_MAP_LEAF_BITS);
+    constexpr std::size_t PAGE_MAP_ROOT_SIZE = (1U << PAGE_MAP_ROOT_BITS);
+
+    // header of a free block, the first block of a batch also links the next batch
+    struct free_block
+    {
+        free_block* m_next;
+        free_block* m_next_batch;
+    };
+
+    static_assert(sizeof(free_block) <= MIN_CACHED_BLOCK_SIZE, "free block header must fit in the smallest block");
+
+    struct size_class_pool
+    {
+        std::mutex m_mtx;
+        free_block* m_batches = nullptr;       // depot: stack of batches of free blocks
+        unsigned char* m_slab_cursor = nullptr; // next block to carve in the current slab chunk
+        unsigned char* m_slab_end = nullptr;
+        std::size_t m_carved_blocks = 0U;
+        std::atomic<std::int64_t> m_outstanding = 0;     // blocks out of the depot (in use or in magazines)
+        std::atomic<std::int64_t> m_high_water_mark = 0; // peak of m_outstanding
+        std::atomic<std::int64_t> m_trim_peak = 0;       // peak of m_outstanding since the last trim pass
+        std::atomic<std::int64_t> m_target = 0;          // blocks retained by the trim pass (decayed peak)
+    };
+
+    using blocks_cache = std::array<size_class_pool, NB_SIZE_CLASSES>;
+
+    // data structure statically allocated in .bss region
+    blocks_cache g_mem_cache = {};
+
+    // registry of the slab chunks (chunk index = address >> SLAB_CHUNK_POW2_SIZE)
+    struct slab_chunk_entry
+    {
+        std::atomic<std::uintptr_t> m_chunk_index;
+        std::size_t m_size_class;
+    };
+
+    std::array<slab_chunk_entry, MAX_SLAB_CHUNKS> g_slab_chunks = {};
+    std::atomic<std::size_t> g_nb_slab_chunks = 0U;
+    std::mutex g_slab_chunks_mtx;
+
+    // leaf entries store size class + 1 (0 = not a slab chunk), leaves are allocated on demand
+    struct page_map_leaf
+    {
+        std::array<std::atomic<std::uint8_t>, PAGE_MAP_LEAF_SIZE> m_entries;
+    };
+
+    std::array<std::atomic<page_map_leaf*>, PAGE_MAP_ROOT_SIZE> g_page_map = {};
+
+    static_assert(NB_SIZE_CLASSES < 255U, "size class must fit in a page map entry");
+
+    struct magazine
+    {
+        std::array<void*, MAGAZINE_CAPACITY> m_blocks;
+        std::size_t m_count;
+    };
+
+    struct class_counters
+    {
+        std::atomic<std::uint64_t> m_allocations;
+        std::atomic<std::uint64_t> m_cache_hits;
+        std::atomic<std::uint64_t> m_recycles;
+        std::atomic<std::uint64_t> m_overflow_frees;
+    };
+
+    struct pool_counters
+    {
+        std::array<class_counters, NB_SIZE_CLASSES> m_classes;
+        std::atomic<std::uint64_t> m_heap_allocations;
+        std::atomic<std::uint64_t> m_heap_frees;
+    };
+
+    // trivially destructible, so the storage stays valid until the very end of the thread
+    struct thread_magazines
+    {
+        std::array<magazine, NB_SIZE_CLASSES> m_magazines;
+        pool_counters m_counters; // written by the owner thread only, read by mem_pool_stats()
+        thread_magazines* m_prev;
+        thread_magazines* m_next;
+        bool m_registered;
+        bool m_released;
+    };
+
+    thread_local thread_magazines t_magazines = {};
+
+    // registry of the live threads counters, plus the counters of the exited threads
+    thread_magazines* g_threads = nullptr;
+    std::mutex g_threads_mtx;
+    pool_counters g_retired_counters = {};
+
+    // single writer counter: relaxed load + store, no locked read-modify-write on the hot path
+    inline void bump(std::atomic<std::uint64_t>& counter) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+    }
+
+    // shared counter (exiting threads)
+    inline void bump_shared(std::atomic<std::uint64_t>& counter) noexcept
+    {
+        counter.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    void fold_counters(pool_counters& into, const pool_counters& from) noexcept
+    {
+        for (std::size_t idx = 0U; idx < NB_SIZE_CLASSES; ++idx)
+        {
+            auto& dst = into.m_classes[idx];
+            const auto& src = from.m_classes[idx];
+            dst.m_allocations.fetch_add(src.m_allocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            dst.m_cache_hits.fetch_add(src.m_cache_hits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            dst.m_recycles.fetch_add(src.m_recycles.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            dst.m_overflow_frees.fetch_add(
+                src.m_overflow_frees.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        into.m_heap_allocations.fetch_add(
+            from.m_heap_allocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        into.m_heap_frees.fetch_add(from.m_heap_frees.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    void register_thread(thread_magazines& magazines) noexcept
+    {
+        std::lock_guard<std::mutex> guard(g_threads_mtx);
+        magazines.m_prev = nullptr;
+        magazines.m_next = g_threads;
+        if (nullptr != g_threads)
+        {
+            g_threads->m_prev = &magazines;
+        }
+        g_threads = &magazines;
+    }
+
+    void unregister_thread(thread_magazines& magazines) noexcept
+    {
+        std::lock_guard<std::mutex> guard(g_threads_mtx);
+        fold_counters(g_retired_counters, magazines.m_counters);
+
+        if (nullptr != magazines.m_prev)
+        {
+            magazines.m_prev->m_next = magazines.m_next;
+        }
+        else
+        {
+            g_threads = magazines.m_next;
+        }
+
+        if (nullptr != magazines.m_next)
+        {
+            magazines.m_next->m_prev = magazines.m_prev;
+        }
+    }
+
+    void flush_magazines(thread_magazines& magazines) noexcept;
+
+    // returns the thread magazines to the depot when the thread exits
+    struct thread_magazines_guard
+    {
+        thread_magazines_guard() = default;
+        thread_magazines_guard(const thread_magazines_guard&) = delete;
+        thread_magazines_guard(thread_magazines_guard&&) = delete;
+        thread_magazines_guard& operator=(const thread_magazines_guard&) = delete;
+        thread_magazines_guard& operator=(thread_magazines_guard&&) = delete;
+
+        ~thread_magazines_guard()
+        {
+            flush_magazines(t_magazines);
+            unregister_thread(t_magazines);
+            // blocks released later by other thread_local destructors go to the depot directly
+            t_magazines.m_released = true;
+        }
+    };
+
+    thread_magazines* local_magazines()
+    {
+        auto& magazines = t_magazines;
+
+        if (magazines.m_released)
+        {
+            return nullptr;
+        }
+
+        if (!magazines.m_registered)
+        {
+            magazines.m_registered = true;
+            register_thread(magazines);
+            static thread_local thread_magazines_guard guard;
+            (void)guard;
+        }
+
+        return &magazines;
+    }
+
+    // size class of a block of at most MAX_CACHED_BLOCK_SIZE bytes
+    constexpr std::size_t size_class(std::size_t size)
+    {
+        return SIZE_CLASS_LOOKUP[(size + SIZE_CLASS_GRANULARITY - 1U) / SIZE_CLASS_GRANULARITY];
+    }
+
+    static_assert(CLASS_BLOCK_SIZES[size_class(0U)] == 16U, "empty blocks use the smallest class");
+    static_assert(CLASS_BLOCK_SIZES[size_class(300U)] == 320U, "300 bytes fit in the 320 bytes class");
+    static_assert(CLASS_BLOCK_SIZES[size_class(MAX_CACHED_BLOCK_SIZE)] == MAX_CACHED_BLOCK_SIZE, "largest class");
+
+    constexpr std::size_t class_blocksize(std::size_t idx)
+    {
+        return CLASS_BLOCK_SIZES[idx];
+    }
+
+    // blocks exchanged with the depot at once
+    constexpr std::size_t magazine_batch(std::size_t idx)
+    {
+        return (MAGAZINE_CAPACITIES[idx] >> 1U);
+    }
+
+    // ------------------------------------------------------------
+    //  Slab chunks
+    // ------------------------------------------------------------
+
+    // reserve a chunk of SLAB_CHUNK_SIZE bytes aligned on SLAB_CHUNK_SIZE
+    unsigned char* os_reserve_chunk() noexcept
+    {
+#if defined(_WIN32)
+        return static_cast<unsigned char*>(_aligned_malloc(SLAB_CHUNK_SIZE, SLAB_CHUNK_SIZE));
+#else
+        // over-reserve, then trim the unaligned head and tail
+        const std::size_t reserve_size = SLAB_CHUNK_SIZE << 1U;
+        void* area = mmap(nullptr, reserve_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == area)
+        {
+            return nullptr;
+        }
+
+        const auto base = reinterpret_cast<std::uintptr_t>(area);
+        const auto aligned = (base + SLAB_CHUNK_SIZE - 1U) & ~(static_cast<std::uintptr_t>(SLAB_CHUNK_SIZE) - 1U);
+        const std::size_t head = aligned - base;
+        const std::size_t tail = SLAB_CHUNK_SIZE - head;
+
+        if (head > 0U)
+        {
+            munmap(area, head);
+        }
+        if (tail > 0U)
+        {
+            munmap(reinterpret_cast<void*>(aligned + SLAB_CHUNK_SIZE), tail);
+        }
+
+#if defined(USE_MEM_POOL_ALLOCATOR_HUGE_PAGES) && defined(MADV_HUGEPAGE)
+        madvise(reinterpret_cast<void*>(aligned), SLAB_CHUNK_SIZE, MADV_HUGEPAGE);
+#endif
+
+        return reinterpret_cast<unsigned char*>(aligned);
+#endif
+    }
+
+    void os_release_chunk(unsigned char* chunk) noexcept
+    {
+#if defined(_WIN32)
+        _aligned_free(chunk);
+#else
+        munmap(chunk, SLAB_CHUNK_SIZE);
+#endif
+    }
+
+    // called with the slab chunks mutex held
+    bool set_page_map_entry(std::uintptr_t chunk_index, std::uint8_t value) noexcept
+    {
+        if ((chunk_index >> PAGE_MAP_BITS) != 0U)
+        {
+            return false; // outside of the mapped address space
+        }
+
+        auto& root_entry = g_page_map[chunk_index >> PAGE_MAP_LEAF_BITS];
+        page_map_leaf* leaf = root_entry.load(std::memory_order_acquire);
+
+        if (nullptr == leaf)
+        {
+            // zeroed leaf, never released (calloc does not go through operator new)
+            leaf = static_cast<page_map_leaf*>(std::calloc(1U, sizeof(page_map_leaf)));
+            if (nullptr == leaf)
+            {
+                return false;
+            }
+            root_entry.store(leaf, std::memory_order_release);
+        }
+
+        leaf->m_entries[chunk_index & (PAGE_MAP_LEAF_SIZE - 1U)].store(value, std::memory_order_release);
+
+        return true;
+    }
+
+    // map a new slab chunk for the given size class (called with the size class mutex held)
+    bool add_slab_chunk(size_class_pool& pool, std::size_t idx) noexcept
+    {
+        std::lock_guard<std::mutex> guard(g_slab_chunks_mtx);
+
+        const std::size_t nb_chunks = g_nb_slab_chunks.load(std::memory_order_relaxed);
+        if (nb_chunks >= MAX_SLAB_CHUNKS)
+        {
+            return false;
+        }
+
+        unsigned char* chunk = os_reserve_chunk();
+        if (nullptr == chunk)
+        {
+            return false;
+        }
+
+        const auto chunk_index = reinterpret_cast<std::uintptr_t>(chunk) >> SLAB_CHUNK_POW2_SIZE;
+        if (!set_page_map_entry(chunk_index, static_cast<std::uint8_t>(idx + 1U)))
+        {
+            os_release_chunk(chunk);
+            return false;
+        }
+
+        auto& entry = g_slab_chunks[nb_chunks];
+        entry.m_size_class = idx;
+        entry.m_chunk_index.store(chunk_index, std::memory_order_relaxed);
+        g_nb_slab_chunks.store(nb_chunks + 1U, std::memory_order_release);
+
+        pool.m_slab_cursor = chunk;
+        pool.m_slab_end = chunk + SLAB_CHUNK_SIZE;
+
+        return true;
+    }
+
+    // O(1) lookup of the size class owning a block, returns false for blocks coming from the regular heap
+    bool slab_size_class(const void* ptr, std::size_t& idx) noexcept
+    {
+        const auto chunk_index = reinterpret_cast<std::uintptr_t>(ptr) >> SLAB_CHUNK_POW2_SIZE;
+        if ((chunk_index >> PAGE_MAP_BITS) != 0U)
+        {
+            return false;
+        }
+
+        const page_map_leaf* leaf = g_page_map[chunk_index >> PAGE_MAP_LEAF_BITS].load(std::memory_order_acquire);
+        if (nullptr == leaf)
+        {
+            return false;
+        }
+
+        const std::uint8_t value
+            = leaf->m_entries[chunk_index & (PAGE_MAP_LEAF_SIZE - 1U)].load(std::memory_order_acquire);
+        if (0U == value)
+        {
+            return false;
+        }
+
+        idx = static_cast<std::size_t>(value - 1U);
+        return true;
+    }
+
+    // carve up to max_count blocks from the slab (called with the size class mutex held)
+    std::size_t carve_blocks(size_class_pool& pool, std::size_t idx, void** first, std::size_t max_count) noexcept
+    {
+        const std::size_t block_size = class_blocksize(idx);
+        std::size_t count = 0U;
+
+        while (count < max_count)
+        {
+            // the tail of a chunk too small for a block is left unused
+            if ((static_cast<std::size_t>(pool.m_slab_end - pool.m_slab_cursor) < block_size)
+                && !add_slab_chunk(pool, idx))
+            {
+                break;
+            }
+
+            first[count++] = pool.m_slab_cursor;
+            pool.m_slab_cursor += block_size;
+        }
+
+        pool.m_carved_blocks += count;
+
+        return count;
+    }
+
+    // ------------------------------------------------------------
+    //  Depot
+    // ------------------------------------------------------------
+
+    void raise_peak(std::atomic<std::int64_t>& peak, std::int64_t value) noexcept
+    {
+        auto current = peak.load(std::memory_order_relaxed);
+        while ((value > current) && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void track_outstanding(size_class_pool& pool, std::int64_t delta) noexcept
+    {
+        const auto outstanding = pool.m_outstanding.fetch_add(delta, std::memory_order_relaxed) + delta;
+
+        raise_peak(pool.m_high_water_mark, outstanding);
+        raise_peak(pool.m_trim_peak, outstanding);
+    }
+
+    // pop one batch of free blocks (carve new ones from the slab if the depot is empty)
+    std::size_t depot_pop(std::size_t idx, void** first, std::size_t max_count) noexcept
+    {
+        auto& pool = g_mem_cache[idx];
+        free_block* batch = nullptr;
+        std::size_t count = 0U;
+
+        {
+            std::lock_guard<std::mutex> guard(pool.m_mtx);
+
+            batch = pool.m_batches;
+            if (nullptr == batch)
+            {
+                count = carve_blocks(pool, idx, first, std::min(max_count, magazine_batch(idx)));
+            }
+            else if ((1U == max_count) && (nullptr != batch->m_next))
+            {
+                // take only the head, the remaining blocks stay a batch
+                batch->m_next->m_next_batch = batch->m_next_batch;
+                pool.m_batches = batch->m_next;
+                first[0] = batch;
+                count = 1U;
+            }
+            else
+            {
+                pool.m_batches = batch->m_next_batch;
+            }
+        }
+
+        if (0U == count)
+        {
+            // walk the batch outside of the lock (batches never exceed the magazine capacity)
+            for (free_block* block = batch; (nullptr != block) && (count < max_count); block = block->m_next)
+            {
+                first[count++] = block;
+            }
+        }
+
+        track_outstanding(pool, static_cast<std::int64_t>(count));
+
+        return count;
+    }
+
+    // push a batch of free blocks
+    void depot_push(std::size_t idx, void* const* first, std::size_t count) noexcept
+    {
+        if (0U == count)
+        {
+            return;
+        }
+
+        // link the batch outside of the lock
+        for (std::size_t i = 0U; i < count; ++i)
+        {
+            static_cast<free_block*>(first[i])->m_next
+                = ((i + 1U) < count) ? static_cast<free_block*>(first[i + 1U]) : nullptr;
+        }
+
+        auto* batch = static_cast<free_block*>(first[0]);
+        auto& pool = g_mem_cache[idx];
+
+        {
+            std::lock_guard<std::mutex> guard(pool.m_mtx);
+            batch->m_next_batch = pool.m_batches;
+            pool.m_batches = batch;
+        }
+
+        track_outstanding(pool, -static_cast<std::int64_t>(count));
+    }
+
+    void flush_magazines(thread_magazines& magazines) noexcept
+    {
+        for (std::size_t idx = 0U; idx < NB_SIZE_CLASSES; ++idx)
+        {
+            auto& mag = magazines.m_magazines[idx];
+            depot_push(idx, mag.m_blocks.data(), mag.m_count);
+            mag.m_count = 0U;
+        }
+    }
+
+    // ------------------------------------------------------------
+    //  Thread-local cache
+    // ------------------------------------------------------------
+
+    void* cache_alloc(std::size_t idx)
+    {
+        // reuse a block if possible
+        if (auto* magazines = local_magazines())
+        {
+            auto& mag = magazines->m_magazines[idx];
+            auto& counters = magazines->m_counters.m_classes[idx];
+            bump(counters.m_allocations);
+
+            if (0U == mag.m_count)
+            {
+                // refill a batch from the depot
+                mag.m_count = depot_pop(idx, mag.m_blocks.data(), MAGAZINE_CAPACITIES[idx]);
+            }
+            else
+            {
+                bump(counters.m_cache_hits);
+            }
+
+            // reused block or nullptr
+            return (mag.m_count > 0U) ? mag.m_blocks[--mag.m_count] : nullptr;
+        }
+
+        // thread exiting: use the depot directly
+        bump_shared(g_retired_counters.m_classes[idx].m_allocations);
+        void* cached_ptr = nullptr;
+        return (depot_pop(idx, &cached_ptr, 1U) > 0U) ? cached_ptr : nullptr;
+    }
+
+    void cache_recycle(void* ptr, std::size_t idx) noexcept
+    {
+        // recycle the block
+        if (auto* magazines = local_magazines())
+        {
+            auto& mag = magazines->m_magazines[idx];
+            auto& counters = magazines->m_counters.m_classes[idx];
+            bump(counters.m_recycles);
+
+            if (MAGAZINE_CAPACITIES[idx] == mag.m_count)
+            {
+                bump(counters.m_overflow_frees);
+
+                // flush the oldest (coldest) half to the depot, keep the recently freed blocks
+                const std::size_t batch = magazine_batch(idx);
+                depot_push(idx, mag.m_blocks.data(), batch);
+                std::copy(mag.m_blocks.begin() + batch, mag.m_blocks.begin() + mag.m_count, mag.m_blocks.begin());
+                mag.m_count -= batch;
+            }
+
+            mag.m_blocks[mag.m_count++] = ptr;
+            return;
+        }
+
+        // thread exiting: use the depot directly
+        bump_shared(g_retired_counters.m_classes[idx].m_recycles);
+        depot_push(idx, &ptr, 1U);
+    }
+
+    void count_heap_allocation() noexcept
+    {
+        if (auto* magazines = local_magazines())
+        {
+            bump(magazines->m_counters.m_heap_allocations);
+            return;
+        }
+
+        bump_shared(g_retired_counters.m_heap_allocations);
+    }
+
+    void count_heap_free() noexcept
+    {
+        if (auto* magazines = local_magazines())
+        {
+            bump(magazines->m_counters.m_heap_frees);
+            return;
+        }
+
+        bump_shared(g_retired_counters.m_heap_frees);
+    }
+
+    void* cached_new(std::size_t size)
+    {
+        if (size <= MAX_CACHED_BLOCK_SIZE)
+        {
+            const auto idx = size_class(size);
+
+            if (void* cached_ptr = cache_alloc(idx))
+            {
+                // std::cout << "[reuse] " << class_blocksize(idx) << " bytes\n";
+                return cached_ptr;
+            }
+
+            // slabs exhausted: allocate a block of the class size from the heap
+            size = class_blocksize(idx);
+        }
 
-    constexpr std::size_t MIN_CACHED_BLOCK_SIZE = (1U << MIN_CACHED_BLOCK_POW2_SIZE);
-    constexpr std::size_t MAX_CACHED_BLOCK_SIZE = (1U << MAX_CACHED_BLOCK_POW2_SIZE);
+        // fallback - allocate a new block on the heap
+        if (void* ptr = std::malloc(size))
+        {
+            // std::cout << "[alloc] " << size << " bytes\n";
+            count_heap_allocation();
+            return ptr;
+        }
 
-    constexpr std::size_t MAX_CACHED_BLOCKS_POW2 = 9; // 2^9 = 512 per pool
+        throw std::bad_alloc();
+    }
 
-    struct block_pool
+    void cached_delete(void* ptr, std::size_t size) noexcept
     {
-        std::mutex m_push_mtx;
-        std::mutex m_pop_mtx;
-        tools::lock_free_ring_buffer<void*, MAX_CACHED_BLOCKS_POW2> m_pool;
-    };
+        if (nullptr == ptr)
+        {
+            return;
+        }
 
-    using blocks_cache = std::array<block_pool, MAX_CACHED_BLOCK_POW2_SIZE - MIN_CACHED_BLOCK_POW2_SIZE + 1>;
+        // slab blocks go back to the size class of their chunk, whatever the given size
+        std::size_t idx = 0U;
+        if (slab_size_class(ptr, idx))
+        {
+            cache_recycle(ptr, idx);
+            return;
+        }
 
-    // data structure statically allocated in .bss region
-    blocks_cache g_mem_cache = {};
+        // check opportunity to give the released block to the pool
+        if (size <= MAX_CACHED_BLOCK_SIZE)
+        {
+            // std::cout << "[recycle] " << size << " bytes\n";
+            cache_recycle(ptr, size_class(size));
+            return;
+        }
 
-    // Round up to the next power-of-two with a C++17 fallback.
-    constexpr std::size_t bit_ceil_size(std::size_t value)
+        // std::cout << "[free] sized: " << size << " bytes\n";
+        count_heap_free();
+        std::free(ptr);
+    }
+
+#if defined(USE_MEM_POOL_ALLOCATOR)
+    void unsized_delete(void* ptr) noexcept
     {
-#if (__cplusplus >= 202002L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L))
-        return std::bit_ceil(value);
-#else
-        if (value <= 1U)
+        if (nullptr == ptr)
         {
-            return 1U;
+            return;
         }
 
-        --value;
-        for (std::size_t shift = 1U; shift < (sizeof(std::size_t) * 8U); shift <<= 1U)
+        // slab blocks must go back to their size class, never to the regular heap
+        std::size_t idx = 0U;
+        if (slab_size_class(ptr, idx))
         {
-            value |= (value >> shift);
+            cache_recycle(ptr, idx);
+            return;
         }
-        return value + 1U;
+
+        // std::cout << "[free] unsized\n";
+        count_heap_free();
+        std::free(ptr);
+    }
 #endif
+
+    // natural alignment of the blocks of a size class (slab chunks are aligned on their size)
+    constexpr std::size_t class_alignment(std::size_t idx)
+    {
+        const std::size_t block_size = class_blocksize(idx);
+        return block_size & (~block_size + 1U);
     }
 
-    // Compute log2(value) for a non-zero power-of-two value.
-    constexpr int log2_pow2(std::size_t value)
+    void* heap_aligned_new(std::size_t size, std::size_t alignment)
     {
-#if (__cplusplus >= 202002L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L))
-        return static_cast<int>(std::countr_zero(value));
+        // aligned_alloc requires a size multiple of the alignment
+        const std::size_t aligned_size = ((size + alignment - 1U) / alignment) * alignment;
+
+#if defined(_WIN32)
+        void* ptr = _aligned_malloc(aligned_size, alignment);
 #else
-        int log2_value = 0;
-        while ((value >>= 1U) != 0U)
+        void* ptr = std::aligned_alloc(alignment, aligned_size);
+#endif
+        if (nullptr == ptr)
         {
-            ++log2_value;
+            throw std::bad_alloc();
         }
-        return log2_value;
-#endif
+
+        count_heap_allocation();
+        return ptr;
     }
 
-    constexpr std::size_t pow2_blocksize(std::size_t orig_size)
+    void* cached_aligned_new(std::size_t size, std::align_val_t align)
     {
-        return std::max(bit_ceil_size(orig_size), static_cast<std::size_t>(MIN_CACHED_BLOCK_SIZE));
+        const auto alignment = static_cast<std::size_t>(align);
+        if (size <= MAX_CACHED_BLOCK_SIZE)
+        {
+            // first size class large enough whose blocks are naturally aligned enough
+            for (auto idx = size_class(size); idx < NB_SIZE_CLASSES; ++idx)
+            {
+                if (class_alignment(idx) >= alignment)
+                {
+                    if (void* cached_ptr = cache_alloc(idx))
+                    {
+                        // only slab blocks have the natural alignment of their class, a heap block recycled
+                        // into the class (slabs exhausted) is merely malloc aligned: give it back to the heap
+                        std::size_t owner_idx = 0U;
+                        if (slab_size_class(cached_ptr, owner_idx))
+                        {
+                            return cached_ptr;
+                        }
+
+                        count_heap_free();
+                        std::free(cached_ptr);
+                    }
+                    break;
+                }
+            }
+        }
+
+        // fallback - allocate a new aligned block on the heap
+        return heap_aligned_new(size, alignment);
     }
 
-    constexpr int log2int(std::size_t pow2_size)
+    void cached_aligned_delete(void* ptr) noexcept
     {
-        // input is non-zero and is a pow of 2 (computed previously with pow2_blocksize)
-        return log2_pow2(pow2_size);
+        if (nullptr == ptr)
+        {
+            return;
+        }
+
+        std::size_t idx = 0U;
+        if (slab_size_class(ptr, idx))
+        {
+            cache_recycle(ptr, idx);
+            return;
+        }
+
+        // aligned heap blocks are never recycled (they need the aligned deallocation function)
+        count_heap_free();
+#if defined(_WIN32)
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
     }
 
-    void* cache_alloc(std::size_t size_pow2)
+    // ------------------------------------------------------------
+    //  Trimming
+    // ------------------------------------------------------------
+
+    // scratch storage of the trim pass (no heap allocation while a size class mutex is held)
+    std::mutex g_trim_mtx;
+    std::array<std::uintptr_t, MAX_SLAB_CHUNKS> g_trim_chunks = {};
+    std::array<std::size_t, MAX_SLAB_CHUNKS> g_trim_free_blocks = {};
+
+    constexpr std::size_t RELEASED_CHUNK = ~static_cast<std::size_t>(0U);
+
+    // unregister the given chunks, then unmap them outside of the registry lock
+    void release_slab_chunks(const std::uintptr_t* chunks, const std::size_t* marks, std::size_t nb_chunks) noexcept
     {
-        // reuse a block if possible
-        const int idx = log2int(size_pow2) - MIN_CACHED_BLOCK_POW2_SIZE;
+        {
+            std::lock_guard<std::mutex> guard(g_slab_chunks_mtx);
 
-        auto& cache_entry = g_mem_cache[idx];
-        void* cached_ptr = nullptr;
+            for (std::size_t i = 0U; i < nb_chunks; ++i)
+            {
+                if (RELEASED_CHUNK == marks[i])
+                {
+                    set_page_map_entry(chunks[i], 0U);
+                }
+            }
+
+            const std::size_t nb_registered = g_nb_slab_chunks.load(std::memory_order_relaxed);
+            std::size_t nb_kept = 0U;
+
+            for (std::size_t i = 0U; i < nb_registered; ++i)
+            {
+                const auto chunk_index = g_slab_chunks[i].m_chunk_index.load(std::memory_order_relaxed);
+                const auto* found = std::lower_bound(chunks, chunks + nb_chunks, chunk_index);
+
+                if ((found != (chunks + nb_chunks)) && (*found == chunk_index)
+                    && (RELEASED_CHUNK == marks[found - chunks]))
+                {
+                    continue;
+                }
+
+                g_slab_chunks[nb_kept].m_size_class = g_slab_chunks[i].m_size_class;
+                g_slab_chunks[nb_kept].m_chunk_index.store(chunk_index, std::memory_order_relaxed);
+                ++nb_kept;
+            }
+
+            g_nb_slab_chunks.store(nb_kept, std::memory_order_release);
+        }
+
+        for (std::size_t i = 0U; i < nb_chunks; ++i)
+        {
+            if (RELEASED_CHUNK == marks[i])
+            {
+                os_release_chunk(reinterpret_cast<unsigned char*>(chunks[i] << SLAB_CHUNK_POW2_SIZE));
+            }
+        }
+    }
 
+    // put a detached list of batches back on top of the depot
+    void splice_depot(size_class_pool& pool, free_block* batches, free_block* last_batch) noexcept
+    {
+        if (nullptr == batches)
         {
-            // reader
-            std::lock_guard<std::mutex> guard(cache_entry.m_pop_mtx);
-            cache_entry.m_pool.pop(cached_ptr);
+            return;
         }
 
-        // reused block or nullptr
-        return cached_ptr;
+        std::lock_guard<std::mutex> guard(pool.m_mtx);
+        last_batch->m_next_batch = pool.m_batches;
+        pool.m_batches = batches;
     }
 
-    bool cache_recycle(void* ptr, std::size_t size_pow2)
+    // one trim pass over a size class, returns the number of bytes given back to the system
+    //
+    // The depot is detached under the size class mutex and walked without it: the trimmer runs at idle
+    // priority and must never make an allocating thread wait on that mutex. Blocks of the detached list
+    // belong to the trimmer only, so a chunk whose blocks are all in it is unused and can be unmapped.
+    // Meanwhile the allocating threads see an empty depot and carve or take the heap path.
+    std::size_t trim_size_class(std::size_t idx) noexcept
     {
-        // recycle the block if possible
-        const int idx = log2int(size_pow2) - MIN_CACHED_BLOCK_POW2_SIZE;
+        auto& pool = g_mem_cache[idx];
+        const std::size_t block_size = class_blocksize(idx);
+        const std::size_t blocks_per_chunk = SLAB_CHUNK_SIZE / block_size;
 
-        auto& cache_entry = g_mem_cache[idx];
+        // demand driven target: peak since the last pass, or the previous target decayed
+        const auto peak = pool.m_trim_peak.exchange(
+            pool.m_outstanding.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        auto target = pool.m_target.load(std::memory_order_relaxed);
+        target = std::max(peak, target - (target >> TRIM_DECAY_SHIFT));
+        pool.m_target.store(target, std::memory_order_relaxed);
 
-        // writer
-        std::lock_guard<std::mutex> guard(cache_entry.m_push_mtx);
+        free_block* detached = nullptr;
+        std::uintptr_t carved_chunk = 0U;
+        std::size_t carved_blocks = 0U;
 
-        return cache_entry.m_pool.push(ptr);
-    }
+        {
+            std::lock_guard<std::mutex> guard(pool.m_mtx);
+            detached = std::exchange(pool.m_batches, nullptr);
+
+            // chunks of the size class, except the one being carved
+            carved_chunk = (nullptr != pool.m_slab_end)
+                ? (reinterpret_cast<std::uintptr_t>(pool.m_slab_end - 1) >> SLAB_CHUNK_POW2_SIZE)
+                : 0U;
+            carved_blocks = pool.m_carved_blocks;
+        }
 
-    void* cached_new(std::size_t size)
-    {
-        const auto size_pow2 = pow2_blocksize(size);
+        if (nullptr == detached)
+        {
+            return 0U;
+        }
+
+        std::size_t nb_chunks = 0U;
 
-        if (size_pow2 <= MAX_CACHED_BLOCK_SIZE)
         {
-            if (void* cached_ptr = cache_alloc(size_pow2))
+            std::lock_guard<std::mutex> chunks_guard(g_slab_chunks_mtx);
+            const std::size_t nb_registered = g_nb_slab_chunks.load(std::memory_order_relaxed);
+
+            for (std::size_t i = 0U; i < nb_registered; ++i)
             {
-                // std::cout << "[reuse] " << size_pow2 << " bytes\n";
-                return cached_ptr;
+                const auto chunk_index = g_slab_chunks[i].m_chunk_index.load(std::memory_order_relaxed);
+                if ((idx == g_slab_chunks[i].m_size_class) && (carved_chunk != chunk_index))
+                {
+                    g_trim_chunks[nb_chunks] = chunk_index;
+                    g_trim_free_blocks[nb_chunks] = 0U;
+                    ++nb_chunks;
+                }
+            }
+        }
+
+        auto* const chunks_begin = g_trim_chunks.data();
+        auto* const chunks_end = chunks_begin + nb_chunks;
+        std::sort(chunks_begin, chunks_end);
+
+        // count the free blocks of each chunk
+        std::size_t nb_heap_blocks = 0U;
+        free_block* last_batch = nullptr;
+
+        for (free_block* batch = detached; nullptr != batch; batch = batch->m_next_batch)
+        {
+            last_batch = batch;
+
+            for (free_block* block = batch; nullptr != block; block = block->m_next)
+            {
+                const auto chunk_index = reinterpret_cast<std::uintptr_t>(block) >> SLAB_CHUNK_POW2_SIZE;
+                const auto* found = std::lower_bound(chunks_begin, chunks_end, chunk_index);
+
+                if ((found != chunks_end) && (*found == chunk_index))
+                {
+                    ++g_trim_free_blocks[static_cast<std::size_t>(found - chunks_begin)];
+                }
+                else if (std::size_t owner_idx = 0U; !slab_size_class(block, owner_idx))
+                {
+                    ++nb_heap_blocks;
+                }
             }
+        }
+
+        // release the fully free chunks beyond the target
+        auto excess = static_cast<std::int64_t>(carved_blocks) - target;
+        std::size_t nb_released = 0U;
 
-            // allocate a pow of 2 block from the heap
-            size = size_pow2;
+        for (std::size_t i = 0U; (i < nb_chunks) && (excess >= static_cast<std::int64_t>(blocks_per_chunk)); ++i)
+        {
+            if (blocks_per_chunk == g_trim_free_blocks[i])
+            {
+                g_trim_free_blocks[i] = RELEASED_CHUNK;
+                excess -= static_cast<std::int64_t>(blocks_per_chunk);
+                ++nb_released;
+            }
         }
 
-        // fallback - allocate a new block on the heap
-        if (void* ptr = std::malloc(size))
+        // heap blocks are cold once the slabs alone cover the target
+        const bool free_heap_blocks = (nb_heap_blocks > 0U) && (excess >= 0);
+
+        if ((0U == nb_released) && !free_heap_blocks)
         {
-            // std::cout << "[alloc] " << size << " bytes\n";
-            return ptr;
+            splice_depot(pool, detached, last_batch);
+            return 0U;
         }
 
-        throw std::bad_alloc();
-    }
+        // rebuild the depot without the blocks given back
+        const std::size_t batch_size = std::max(magazine_batch(idx), static_cast<std::size_t>(1U));
+        free_block* kept_batches = nullptr;
+        free_block* kept_last_batch = nullptr;
+        free_block* current_batch = nullptr;
+        free_block* current_tail = nullptr;
+        std::size_t current_count = 0U;
+        std::size_t released_bytes = 0U;
 
-    void cached_delete(void* ptr, std::size_t size) noexcept
-    {
-        // check opportunity to give the released block to the pool
-        const auto size_pow2 = pow2_blocksize(size);
+        auto keep_batch = [&kept_batches, &kept_last_batch](free_block* batch)
+        {
+            batch->m_next_batch = kept_batches;
+            kept_batches = batch;
+            if (nullptr == kept_last_batch)
+            {
+                kept_last_batch = batch;
+            }
+        };
+
+        free_block* batch = detached;
+        while (nullptr != batch)
+        {
+            free_block* next_batch = batch->m_next_batch;
+            free_block* block = batch;
 
-        if (size_pow2 <= MAX_CACHED_BLOCK_SIZE)
+            while (nullptr != block)
+            {
+                free_block* next_block = block->m_next;
+                const auto chunk_index = reinterpret_cast<std::uintptr_t>(block) >> SLAB_CHUNK_POW2_SIZE;
+                const auto* found = std::lower_bound(chunks_begin, chunks_end, chunk_index);
+                const bool in_listed_chunk = (found != chunks_end) && (*found == chunk_index);
+                std::size_t owner_idx = 0U;
+
+                if (in_listed_chunk && (RELEASED_CHUNK == g_trim_free_blocks[found - chunks_begin]))
+                {
+                    // dropped with its chunk
+                }
+                else if (!in_listed_chunk && free_heap_blocks && !slab_size_class(block, owner_idx))
+                {
+                    count_heap_free();
+                    std::free(block);
+                    released_bytes += block_size;
+                }
+                else
+                {
+                    if ((nullptr == current_batch) || (batch_size == current_count))
+                    {
+                        if (nullptr != current_batch)
+                        {
+                            keep_batch(current_batch);
+                        }
+                        current_batch = block;
+                        current_count = 0U;
+                    }
+                    else
+                    {
+                        current_tail->m_next = block;
+                    }
+
+                    block->m_next = nullptr;
+                    current_tail = block;
+                    ++current_count;
+                }
+
+                block = next_block;
+            }
+
+            batch = next_batch;
+        }
+
+        if (nullptr != current_batch)
         {
-            const bool recycled = cache_recycle(ptr, size_pow2);
+            keep_batch(current_batch);
+        }
 
-            if (recycled)
+        if (nb_released > 0U)
+        {
             {
-                // std::cout << "[recycle] " << size_pow2 << " bytes\n";
-                //  block recycled
-                return;
+                std::lock_guard<std::mutex> guard(pool.m_mtx);
+                pool.m_carved_blocks -= nb_released * blocks_per_chunk;
+                if (nullptr != kept_batches)
+                {
+                    kept_last_batch->m_next_batch = pool.m_batches;
+                    pool.m_batches = kept_batches;
+                }
             }
 
-            // fallback on regular heap deallocation
+            release_slab_chunks(chunks_begin, g_trim_free_blocks.data(), nb_chunks);
+            released_bytes += nb_released * SLAB_CHUNK_SIZE;
+        }
+        else
+        {
+            splice_depot(pool, kept_batches, kept_last_batch);
         }
 
-        // std::cout << "[free] sized: " << size << " bytes\n";
-        std::free(ptr);
+        return released_bytes;
     }
 }
 
@@ -218,57 +1184,222 @@ void init_mem_pool_allocator()
 {
 #if defined(USE_MEM_POOL_ALLOCATOR_WARMUP)
 
-    // warm up
+    // warm up: one slab chunk per small size class, prefaulted for the first blocks
 
-    std::size_t block_size = MIN_CACHED_BLOCK_SIZE;
     std::size_t total_mem = 0U;
 
-    for (auto& entry : g_mem_cache)
+    for (std::size_t idx = 0U; (idx < NB_SIZE_CLASSES) && (class_blocksize(idx) <= WARMUP_MAX_BLOCK_SIZE); ++idx)
     {
-        std::scoped_lock lock(entry.m_pop_mtx, entry.m_push_mtx);
+        auto& pool = g_mem_cache[idx];
+        std::lock_guard<std::mutex> guard(pool.m_mtx);
 
-        for (int i = 0; i < (1 << MAX_CACHED_BLOCKS_POW2) - 1; ++i)
+        if ((pool.m_slab_cursor == pool.m_slab_end) && !add_slab_chunk(pool, idx))
         {
-            if (void* ptr = std::malloc(block_size))
-            {
-                // std::cout << "[pre-alloc] " << block_size << " bytes\n";
+            return;
+        }
+
+        const std::size_t warmup_size = std::min(WARMUP_BLOCKS_PER_CLASS * class_blocksize(idx),
+            static_cast<std::size_t>(pool.m_slab_end - pool.m_slab_cursor));
+        std::fill_n(pool.m_slab_cursor, warmup_size, static_cast<unsigned char>(0U));
+
+        total_mem += warmup_size;
+    } // end fill memory cache
+
+    // std::cout << "[total mem] " << total_mem << " bytes pre-allocated in memory pool\n";
+    (void)total_mem;
+#endif
+}
+
+void destroy_mem_pool_allocator()
+{
+    // give back the blocks cached by the calling thread
+    flush_magazines(t_magazines);
+
+    // release all the heap blocks from the pool
+
+    std::array<std::size_t, NB_SIZE_CLASSES> free_slab_blocks = {};
+
+    for (std::size_t idx = 0U; idx < NB_SIZE_CLASSES; ++idx)
+    {
+        auto& pool = g_mem_cache[idx];
+        std::lock_guard<std::mutex> guard(pool.m_mtx);
+
+        free_block* kept_batch = nullptr;
+        free_block* batch = pool.m_batches;
+
+        while (nullptr != batch)
+        {
+            free_block* next_batch = batch->m_next_batch;
+            free_block* block = batch;
 
-                total_mem += block_size;
+            while (nullptr != block)
+            {
+                free_block* next_block = block->m_next;
+                std::size_t owner_idx = 0U;
 
-                if (!entry.m_pool.push(ptr))
+                if (slab_size_class(block, owner_idx))
                 {
-                    // std::cerr << "[pre-alloc] " << block_size << " bytes failed !\n";
+                    // keep slab blocks in single block batches
+                    block->m_next = nullptr;
+                    block->m_next_batch = kept_batch;
+                    kept_batch = block;
+                    ++free_slab_blocks[idx];
                 }
+                else
+                {
+                    std::free(block);
+                }
+
+                block = next_block;
             }
-            else
-            {
-                return;
-            }
+
+            batch = next_batch;
         }
 
-        block_size <<= 1;
-    } // end fill memory cache
+        pool.m_batches = kept_batch;
+    }
 
-    // std::cout << "[total mem] " << total_mem << " bytes pre-allocated in memory pool\n";
-#endif
+    // unmap the slab chunks of the size classes whose blocks are all back in the depot
+    // (blocks still in use by static objects or other threads must stay valid)
+
+    std::lock_guard<std::mutex> guard(g_slab_chunks_mtx);
+
+    const std::size_t nb_chunks = g_nb_slab_chunks.load(std::memory_order_relaxed);
+    std::size_t nb_kept_chunks = 0U;
+
+    for (std::size_t i = 0U; i < nb_chunks; ++i)
+    {
+        const std::size_t idx = g_slab_chunks[i].m_size_class;
+        auto& pool = g_mem_cache[idx];
+        const auto chunk_index = g_slab_chunks[i].m_chunk_index.load(std::memory_order_relaxed);
+
+        if (free_slab_blocks[idx] == pool.m_carved_blocks)
+        {
+            set_page_map_entry(chunk_index, 0U);
+            os_release_chunk(reinterpret_cast<unsigned char*>(chunk_index << SLAB_CHUNK_POW2_SIZE));
+            pool.m_batches = nullptr;
+            pool.m_slab_cursor = nullptr;
+            pool.m_slab_end = nullptr;
+        }
+        else
+        {
+            g_slab_chunks[nb_kept_chunks].m_size_class = idx;
+            g_slab_chunks[nb_kept_chunks].m_chunk_index.store(chunk_index, std::memory_order_relaxed);
+            ++nb_kept_chunks;
+        }
+    }
+
+    for (std::size_t idx = 0U; idx < NB_SIZE_CLASSES; ++idx)
+    {
+        if (nullptr == g_mem_cache[idx].m_slab_end)
+        {
+            g_mem_cache[idx].m_carved_blocks = 0U;
+        }
+    }
+
+    g_nb_slab_chunks.store(nb_kept_chunks, std::memory_order_release);
 }
 
-void destroy_mem_pool_allocator()
+tools::mem_pool_stats_snapshot tools::mem_pool_stats()
 {
-    // release all blocks from the pool
+    mem_pool_stats_snapshot snapshot;
+    // allocate before taking the registry lock (the allocation may register the calling thread)
+    snapshot.size_classes.resize(NB_SIZE_CLASSES);
+
+    pool_counters totals = {};
+
+    {
+        std::lock_guard<std::mutex> guard(g_threads_mtx);
 
-    for (auto& entry : g_mem_cache)
+        fold_counters(totals, g_retired_counters);
+        for (const thread_magazines* thread = g_threads; nullptr != thread; thread = thread->m_next)
+        {
+            fold_counters(totals, thread->m_counters);
+        }
+    }
+
+    for (std::size_t idx = 0U; idx < NB_SIZE_CLASSES; ++idx)
     {
-        std::scoped_lock lock(entry.m_pop_mtx, entry.m_push_mtx);
+        const auto& counters = totals.m_classes[idx];
+        auto& class_stats = snapshot.size_classes[idx];
+
+        class_stats.block_size = class_blocksize(idx);
+        class_stats.allocations = counters.m_allocations.load(std::memory_order_relaxed);
+        class_stats.cache_hits = counters.m_cache_hits.load(std::memory_order_relaxed);
+        class_stats.recycles = counters.m_recycles.load(std::memory_order_relaxed);
+        class_stats.overflow_frees = counters.m_overflow_frees.load(std::memory_order_relaxed);
+        class_stats.live_blocks
+            = static_cast<std::int64_t>(class_stats.allocations) - static_cast<std::int64_t>(class_stats.recycles);
+        class_stats.high_water_mark = g_mem_cache[idx].m_high_water_mark.load(std::memory_order_relaxed);
+        class_stats.target_blocks = g_mem_cache[idx].m_target.load(std::memory_order_relaxed);
+    }
+
+    snapshot.heap_allocations = totals.m_heap_allocations.load(std::memory_order_relaxed);
+    snapshot.heap_frees = totals.m_heap_frees.load(std::memory_order_relaxed);
+    snapshot.slab_chunks = g_nb_slab_chunks.load(std::memory_order_acquire);
+    snapshot.slab_bytes = snapshot.slab_chunks * SLAB_CHUNK_SIZE;
+
+    return snapshot;
+}
 
-        void* block = nullptr;
-        while (entry.m_pool.pop(block))
+void tools::dump_mem_pool_stats(std::ostream& out, const mem_pool_stats_snapshot& stats)
+{
+    out << "[mem pool] slab chunks: " << stats.slab_chunks << " (" << stats.slab_bytes
+        << " bytes), heap allocations: " << stats.heap_allocations << ", heap frees: " << stats.heap_frees << '\n';
+
+    for (const auto& class_stats : stats.size_classes)
+    {
+        if (0U == class_stats.allocations)
         {
-            std::free(block);
+            continue;
         }
+
+        const double hit_ratio = (100.0 * static_cast<double>(class_stats.cache_hits))
+            / static_cast<double>(class_stats.allocations);
+
+        out << "[mem pool] " << class_stats.block_size << " bytes: allocations=" << class_stats.allocations
+            << " cache hits=" << class_stats.cache_hits << " (" << hit_ratio << "%) recycles=" << class_stats.recycles
+            << " overflow frees=" << class_stats.overflow_frees << " live=" << class_stats.live_blocks
+            << " high water mark=" << class_stats.high_water_mark << " target=" << class_stats.target_blocks << '\n';
+    }
+}
+
+void* tools::mem_pool_allocate(std::size_t size, std::size_t alignment)
+{
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        return cached_new(size);
+    }
+
+    return cached_aligned_new(size, static_cast<std::align_val_t>(alignment));
+}
+
+void tools::mem_pool_deallocate(void* ptr, std::size_t size, std::size_t alignment) noexcept
+{
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        cached_delete(ptr, size);
+        return;
     }
+
+    cached_aligned_delete(ptr);
+}
+
+std::size_t tools::trim_mem_pool()
+{
+    std::lock_guard<std::mutex> guard(g_trim_mtx);
+
+    std::size_t released_bytes = 0U;
+    for (std::size_t idx = 0U; idx < NB_SIZE_CLASSES; ++idx)
+    {
+        released_bytes += trim_size_class(idx);
+    }
+
+    return released_bytes;
 }
 
+#if defined(USE_MEM_POOL_ALLOCATOR)
+
 // ------------------------------------------------------------
 //  Global operator new (scalar)
 // ------------------------------------------------------------
@@ -283,9 +1414,8 @@ void* operator new(std::size_t size)
 // ------------------------------------------------------------
 void operator delete(void* ptr) noexcept
 {
-    // Intentionally bypass cache: unsized delete does not know the exact block size.
-    // Modern C++ containers and value types typically use sized delete in practice.
-    std::free(ptr);
+    // unsized delete does not know the block size: look up the owning slab chunk
+    unsized_delete(ptr);
 }
 
 // ------------------------------------------------------------
@@ -309,9 +1439,8 @@ void* operator new[](std::size_t size)
 
 void operator delete[](void* ptr) noexcept
 {
-    // Intentionally bypass cache: unsized delete[] does not know the exact block size.
-    // Modern C++ containers and value types typically use sized delete[] in practice.
-    std::free(ptr);
+    // unsized delete[] does not know the block size: look up the owning slab chunk
+    unsized_delete(ptr);
 }
 
 void operator delete[](void* ptr, std::size_t size) noexcept
@@ -320,6 +1449,48 @@ void operator delete[](void* ptr, std::size_t size) noexcept
     cached_delete(ptr, size);
 }
 
+// ------------------------------------------------------------
+//  Aligned versions — C++17
+//  Called for over-aligned types (alignof > __STDCPP_DEFAULT_NEW_ALIGNMENT__).
+// ------------------------------------------------------------
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    // std::cout << "[new aligned] " << size << " bytes\n";
+    return cached_aligned_new(size, align);
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+    // std::cout << "[new[] aligned] " << size << " bytes\n";
+    return cached_aligned_new(size, align);
+}
+
+void operator delete(void* ptr, std::align_val_t align) noexcept
+{
+    (void)align;
+    cached_aligned_delete(ptr);
+}
+
+void operator delete(void* ptr, std::size_t size, std::align_val_t align) noexcept
+{
+    (void)size;
+    (void)align;
+    cached_aligned_delete(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t align) noexcept
+{
+    (void)align;
+    cached_aligned_delete(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t size, std::align_val_t align) noexcept
+{
+    (void)size;
+    (void)align;
+    cached_aligned_delete(ptr);
+}
+
 #if 0
 // ---------------------------------------------------------------------
 //  Nothrow versions (not cached because there is no sized destructors
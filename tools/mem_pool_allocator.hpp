@@ -0,0 +1,129 @@
+/**
+ * @file mem_pool_allocator.hpp
+ * @brief Public API of the custom mem pool allocator (caching/reusing) overriding the global new/delete
+ *
+ * This file declares the initialization/destruction functions of the mem pool allocator
+ * and its runtime statistics API (per size class counters and a textual dump).
+ *
+ * @author Laurent Lardinois
+ * @date October 2026
+ */
+
+//-----------------------------------------------------------------------------//
+// C++ Publish/Subscribe Pattern - Spare time development for fun              //
+// (c) 2025-2026 Laurent Lardinois https://be.linkedin.com/in/laurentlardinois //
+//                                                                             //
+// https://github.com/type-one/PublishSubscribe                                //
+//                                                                             //
+// MIT License                                                                 //
+//                                                                             //
+// This software is provided 'as-is', without any express or implied           //
+// warranty.In no event will the authors be held liable for any damages        //
+// arising from the use of this software.                                      //
+//                                                                             //
+// Permission is granted to anyone to use this software for any purpose,       //
+// including commercial applications, and to alter itand redistribute it       //
+// freely, subject to the following restrictions :                             //
+//                                                                             //
+// 1. The origin of this software must not be misrepresented; you must not     //
+// claim that you wrote the original software.If you use this software         //
+// in a product, an acknowledgment in the product documentation would be       //
+// appreciated but is not required.                                            //
+// 2. Altered source versions must be plainly marked as such, and must not be  //
+// misrepresented as being the original software.                              //
+// 3. This notice may not be removed or altered from any source distribution.  //
+//-----------------------------------------------------------------------------//
+
+#pragma once
+
+#if !defined(MEM_POOL_ALLOCATOR_HPP_)
+#define MEM_POOL_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+// https://www.rastergrid.com/blog/sw-eng/2021/03/custom-memory-allocators/
+void init_mem_pool_allocator();
+void destroy_mem_pool_allocator();
+
+namespace tools
+{
+    /**
+     * @brief Counters of one size class of the mem pool.
+     */
+    struct mem_pool_class_stats
+    {
+        std::size_t block_size = 0U;
+        std::uint64_t allocations = 0U;     // blocks allocated in this size class
+        std::uint64_t cache_hits = 0U;      // allocations served by the thread magazine without touching the depot
+        std::uint64_t recycles = 0U;        // blocks given back to the pool
+        std::uint64_t overflow_frees = 0U;  // full magazines flushed to the shared depot
+        std::int64_t live_blocks = 0;       // blocks currently in use (allocations - recycles)
+        std::int64_t high_water_mark = 0;   // peak number of blocks out of the depot (in use or in magazines)
+        std::int64_t target_blocks = 0;     // blocks retained by the trim pass (decayed peak demand)
+    };
+
+    /**
+     * @brief Snapshot of the mem pool counters.
+     *
+     * Counters are relaxed per-thread counters summed at snapshot time, so the
+     * snapshot is approximate while other threads keep allocating.
+     */
+    struct mem_pool_stats_snapshot
+    {
+        std::vector<mem_pool_class_stats> size_classes;
+        std::uint64_t heap_allocations = 0U; // blocks allocated with std::malloc (too large or slabs exhausted)
+        std::uint64_t heap_frees = 0U;       // blocks released with std::free
+        std::size_t slab_chunks = 0U;        // slab chunks currently mapped
+        std::size_t slab_bytes = 0U;         // bytes of slab chunks currently mapped
+    };
+
+    /**
+     * @brief Allocates a block from the mem pool size classes.
+     *
+     * Usable without replacing the global new/delete (see mem_pool_resource.hpp).
+     * Blocks too large for the size classes come from the regular heap.
+     *
+     * @param size Size of the block in bytes.
+     * @param alignment Required alignment of the block (power of 2).
+     * @return Pointer to the allocated block. Throws std::bad_alloc on failure.
+     */
+    [[nodiscard]] void* mem_pool_allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Gives back a block obtained from mem_pool_allocate.
+     *
+     * @param ptr Pointer to the block (nullptr is ignored).
+     * @param size Size given to mem_pool_allocate.
+     * @param alignment Alignment given to mem_pool_allocate.
+     */
+    void mem_pool_deallocate(void* ptr, std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept;
+
+    /**
+     * @brief One trim pass over the mem pool size classes.
+     *
+     * Each size class keeps a target equal to the peak number of blocks out of the depot since
+     * the previous pass (decayed when the demand drops). Slab chunks whose blocks are all free
+     * beyond that target are given back to the system. Meant to run periodically from a low
+     * priority task (see mem_pool_trimmer.hpp).
+     *
+     * @return Number of bytes given back to the system.
+     */
+    std::size_t trim_mem_pool();
+
+    /**
+     * @brief Returns a snapshot of the mem pool statistics.
+     */
+    [[nodiscard]] mem_pool_stats_snapshot mem_pool_stats();
+
+    /**
+     * @brief Writes a human readable dump of a mem pool statistics snapshot.
+     *
+     * Can be called from a periodic_task for a periodic dump.
+     */
+    void dump_mem_pool_stats(std::ostream& out, const mem_pool_stats_snapshot& stats);
+}
+
+#endif //  MEM_POOL_ALLOCATOR_HPP_
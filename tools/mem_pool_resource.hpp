@@ -0,0 +1,113 @@
+/**
+ * @file mem_pool_resource.hpp
+ * @brief std::pmr memory resources backed by the mem pool size classes.
+ * @author Laurent Lardinois
+ * @date October 2026
+ */
+
+//-----------------------------------------------------------------------------//
+// C++ Publish/Subscribe Pattern - Spare time development for fun              //
+// (c) 2025-2026 Laurent Lardinois https://be.linkedin.com/in/laurentlardinois //
+//                                                                             //
+// https://github.com/type-one/PublishSubscribe                                //
+//                                                                             //
+// MIT License                                                                 //
+//                                                                             //
+// This software is provided 'as-is', without any express or implied           //
+// warranty.In no event will the authors be held liable for any damages        //
+// arising from the use of this software.                                      //
+//                                                                             //
+// Permission is granted to anyone to use this software for any purpose,       //
+// including commercial applications, and to alter itand redistribute it       //
+// freely, subject to the following restrictions :                             //
+//                                                                             //
+// 1. The origin of this software must not be misrepresented; you must not     //
+// claim that you wrote the original software.If you use this software         //
+// in a product, an acknowledgment in the product documentation would be       //
+// appreciated but is not required.                                            //
+// 2. Altered source versions must be plainly marked as such, and must not be  //
+// misrepresented as being the original software.                              //
+// 3. This notice may not be removed or altered from any source distribution.  //
+//-----------------------------------------------------------------------------//
+
+#pragma once
+
+#if !defined(MEM_POOL_RESOURCE_HPP_)
+#define MEM_POOL_RESOURCE_HPP_
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "tools/mem_pool_allocator.hpp"
+
+namespace tools
+{
+    /**
+     * @brief Polymorphic memory resource serving its blocks from the mem pool size classes.
+     *
+     * Lets individual containers use the pool (thread magazines, slab chunks) without
+     * replacing the global new/delete for the whole process. All instances share the
+     * same global pool, so they compare equal.
+     */
+    class mem_pool_resource : public std::pmr::memory_resource
+    {
+    public:
+        mem_pool_resource() = default;
+        ~mem_pool_resource() override = default;
+
+        mem_pool_resource(const mem_pool_resource&) = default;
+        mem_pool_resource& operator=(const mem_pool_resource&) = default;
+        mem_pool_resource(mem_pool_resource&&) = default;
+        mem_pool_resource& operator=(mem_pool_resource&&) = default;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            return mem_pool_allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            mem_pool_deallocate(ptr, bytes, alignment);
+        }
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return (this == &other) || (nullptr != dynamic_cast<const mem_pool_resource*>(&other));
+        }
+    };
+
+    /**
+     * @brief Returns the process wide mem pool memory resource.
+     */
+    [[nodiscard]] inline std::pmr::memory_resource* mem_pool_memory_resource() noexcept
+    {
+        static mem_pool_resource resource;
+        return &resource;
+    }
+
+    /**
+     * @brief Returns the monotonic arena of the calling thread.
+     *
+     * Bump-pointer allocation carved from mem pool blocks; deallocation is a no-op and the
+     * memory is only given back by release_thread_arena() or at thread exit. Only for
+     * containers confined to the calling thread (the arena is not thread-safe).
+     */
+    [[nodiscard]] inline std::pmr::memory_resource* thread_arena_memory_resource()
+    {
+        thread_local std::pmr::monotonic_buffer_resource arena(mem_pool_memory_resource());
+        return &arena;
+    }
+
+    /**
+     * @brief Gives back all the memory of the calling thread arena to the mem pool.
+     *
+     * Every object allocated from the arena of the calling thread must be destroyed first.
+     */
+    inline void release_thread_arena()
+    {
+        static_cast<std::pmr::monotonic_buffer_resource*>(thread_arena_memory_resource())->release();
+    }
+}
+
+#endif //  MEM_POOL_RESOURCE_HPP_
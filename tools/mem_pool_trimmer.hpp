@@ -0,0 +1,113 @@
+/**
+ * @file mem_pool_trimmer.hpp
+ * @brief Background trimming of the mem pool on a low priority periodic task.
+ * @author Laurent Lardinois
+ * @date October 2026
+ */
+
+//-----------------------------------------------------------------------------//
+// C++ Publish/Subscribe Pattern - Spare time development for fun              //
+// (c) 2025-2026 Laurent Lardinois https://be.linkedin.com/in/laurentlardinois //
+//                                                                             //
+// https://github.com/type-one/PublishSubscribe                                //
+//                                                                             //
+// MIT License                                                                 //
+//                                                                             //
+// This software is provided 'as-is', without any express or implied           //
+// warranty.In no event will the authors be held liable for any damages        //
+// arising from the use of this software.                                      //
+//                                                                             //
+// Permission is granted to anyone to use this software for any purpose,       //
+// including commercial applications, and to alter itand redistribute it       //
+// freely, subject to the following restrictions :                             //
+//                                                                             //
+// 1. The origin of this software must not be misrepresented; you must not     //
+// claim that you wrote the original software.If you use this software         //
+// in a product, an acknowledgment in the product documentation would be       //
+// appreciated but is not required.                                            //
+// 2. Altered source versions must be plainly marked as such, and must not be  //
+// misrepresented as being the original software.                              //
+// 3. This notice may not be removed or altered from any source distribution.  //
+//-----------------------------------------------------------------------------//
+
+#pragma once
+
+#if !defined(MEM_POOL_TRIMMER_HPP_)
+#define MEM_POOL_TRIMMER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "tools/mem_pool_allocator.hpp"
+#include "tools/non_copyable.hpp"
+#include "tools/periodic_task.hpp"
+
+namespace tools
+{
+    /**
+     * @brief Runs tools::trim_mem_pool() periodically on a low priority thread.
+     *
+     * Each size class grows to its observed peak working set and decays back over time,
+     * so bursts are served by retained blocks while idle periods give the slab chunks
+     * back to the system. The periodic thread uses SCHED_IDLE where available.
+     */
+    class mem_pool_trimmer : public non_copyable // NOLINT inherits from non copyable/non movable
+    {
+    public:
+        mem_pool_trimmer() = delete;
+
+        explicit mem_pool_trimmer(
+            const std::chrono::duration<int, std::micro>& period = std::chrono::duration<int, std::micro>(1000000))
+            : m_context { std::make_shared<trim_context>() }
+            , m_task { trim_pass, m_context, "mem pool trimmer", period, periodic_overrun_policy::skip_missed,
+                background_profile() }
+        {
+        }
+
+        ~mem_pool_trimmer() = default;
+
+        // number of trim passes done so far
+        [[nodiscard]] std::uint64_t passes() const
+        {
+            return m_context->m_passes.load(std::memory_order_relaxed);
+        }
+
+        // bytes given back to the system so far
+        [[nodiscard]] std::uint64_t released_bytes() const
+        {
+            return m_context->m_released_bytes.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct trim_context
+        {
+            std::atomic<std::uint64_t> m_passes = 0U;
+            std::atomic<std::uint64_t> m_released_bytes = 0U;
+        };
+
+        static realtime_profile background_profile()
+        {
+            realtime_profile profile;
+            profile.use_deadline = false;
+            profile.fallback_policy = realtime_policy::idle;
+            profile.fallback_priority = 0;
+            return profile;
+        }
+
+        static void trim_pass(std::shared_ptr<trim_context> context, const std::string& task_name)
+        {
+            (void)task_name;
+            const auto released = trim_mem_pool();
+            context->m_released_bytes.fetch_add(released, std::memory_order_relaxed);
+            context->m_passes.fetch_add(1U, std::memory_order_relaxed);
+        }
+
+        std::shared_ptr<trim_context> m_context;
+        periodic_task<trim_context> m_task;
+    };
+}
+
+#endif //  MEM_POOL_TRIMMER_HPP_
@@ -0,0 +1,412 @@
+/**
+ * @file periodic_scheduler.hpp
+ * @brief Implementation of a multiplexed periodic scheduler
+ *
+ * This file contains the implementation of the periodic_scheduler class, which hosts many
+ * periodic routines with different periods on one or a few threads, instead of spawning
+ * one thread per routine like periodic_task does.
+ *
+ * @author Laurent Lardinois
+ * @date October 2026
+ */
+
+//-----------------------------------------------------------------------------//
+// C++ Publish/Subscribe Pattern - Spare time development for fun              //
+// (c) 2025-2026 Laurent Lardinois https://be.linkedin.com/in/laurentlardinois //
+//                                                                             //
+// https://github.com/type-one/PublishSubscribe                                //
+//                                                                             //
+// MIT License                                                                 //
+//                                                                             //
+// This software is provided 'as-is', without any express or implied           //
+// warranty.In no event will the authors be held liable for any damages        //
+// arising from the use of this software.                                      //
+//                                                                             //
+// Permission is granted to anyone to use this software for any purpose,       //
+// including commercial applications, and to alter itand redistribute it       //
+// freely, subject to the following restrictions :                             //
+//                                                                             //
+// 1. The origin of this software must not be misrepresented; you must not     //
+// claim that you wrote the original software.If you use this software         //
+// in a product, an acknowledgment in the product documentation would be       //
+// appreciated but is not required.                                            //
+// 2. Altered source versions must be plainly marked as such, and must not be  //
+// misrepresented as being the original software.                              //
+// 3. This notice may not be removed or altered from any source distribution.  //
+//-----------------------------------------------------------------------------//
+
+#pragma once
+
+#if !defined(PERIODIC_SCHEDULER_HPP_)
+#define PERIODIC_SCHEDULER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+#include "tools/non_copyable.hpp"
+#include "tools/sync_object.hpp"
+#include "tools/time_list.hpp"
+
+namespace tools
+{
+    /**
+     * @brief Class multiplexing many periodic routines on a small set of threads.
+     *
+     * Each hosting thread ("lane") orders the next deadlines of its routines in a
+     * min-heap (@ref time_list) and sleeps until the earliest one. All deadlines are
+     * aligned on a common epoch (k * period from the scheduler start), so routines
+     * with harmonic periods (e.g. 10 ms, 20 ms, 40 ms) fall due at the very same
+     * time point and are executed in a single wakeup.
+     *
+     * When rate-monotonic mode is enabled, routines due in the same wakeup run by
+     * increasing period (shortest period = highest priority).
+     *
+     * A routine that overruns does not accumulate a backlog: missed ticks are skipped
+     * and the next deadline stays aligned on the routine period grid.
+     *
+     * @tparam Context The type of the context object associated with the routines.
+     */
+    template <typename Context>
+    class periodic_scheduler : public non_copyable // NOLINT inherits from non copyable/non movable
+    {
+
+    public:
+        using call_back = std::function<void(std::shared_ptr<Context>, const std::string& task_name)>;
+        using routine_id = std::size_t;
+        using clock_type = std::chrono::high_resolution_clock;
+
+        periodic_scheduler() = delete;
+
+        periodic_scheduler(const std::string& scheduler_name, std::size_t nb_threads = 1U, bool rate_monotonic = true)
+            : m_scheduler_name { scheduler_name }
+            , m_rate_monotonic { rate_monotonic }
+            , m_epoch { clock_type::now() }
+        {
+            const std::size_t nb_lanes = std::max<std::size_t>(1U, nb_threads);
+            m_lanes.reserve(nb_lanes);
+
+            for (std::size_t i = 0U; i < nb_lanes; ++i)
+            {
+                m_lanes.emplace_back(std::make_unique<lane>());
+            }
+
+            for (auto& lane_ptr : m_lanes)
+            {
+                lane* current_lane = lane_ptr.get();
+                current_lane->m_task = std::make_unique<std::thread>(
+                    [this, current_lane]()
+                    {
+#if defined(__linux__)
+                        pthread_setname_np(pthread_self(), m_scheduler_name.c_str());
+#endif
+                        lane_loop(*current_lane);
+                    });
+            }
+        }
+
+        ~periodic_scheduler()
+        {
+            m_stop_task.store(true);
+
+            for (auto& lane_ptr : m_lanes)
+            {
+                lane_ptr->m_wakeable.signal();
+                lane_ptr->m_task->join();
+            }
+        }
+
+        /**
+         * @brief Registers a periodic routine.
+         *
+         * The routine is hosted by the least loaded thread (sum of the rates of its routines).
+         * Its first tick is the next multiple of the period from the scheduler epoch.
+         *
+         * @param routine Periodic function to execute.
+         * @param context Context object given to the routine.
+         * @param task_name Name given to the routine.
+         * @param period Period of the routine.
+         * @return Identifier to use with @ref remove.
+         */
+        routine_id add(call_back routine, std::shared_ptr<Context> context, std::string task_name,
+            const std::chrono::duration<int, std::micro>& period)
+        {
+            auto entry = std::make_shared<routine_entry>();
+            entry->m_routine = std::move(routine);
+            entry->m_context = std::move(context);
+            entry->m_task_name = std::move(task_name);
+            entry->m_period = std::max(period, std::chrono::duration<int, std::micro>(1));
+            entry->m_id = m_next_id.fetch_add(1U);
+
+            const double rate = 1.0 / static_cast<double>(entry->m_period.count());
+
+            std::lock_guard<std::mutex> registry_guard(m_registry_mutex);
+
+            auto found = std::min_element(m_lanes.cbegin(), m_lanes.cend(),
+                [](const auto& lhs, const auto& rhs) { return lhs->m_load < rhs->m_load; });
+            lane& target = **found;
+            target.m_load += rate;
+            m_routine_lane.emplace(entry->m_id, &target);
+
+            {
+                std::lock_guard<std::mutex> guard(target.m_mutex);
+                entry->m_deadline = next_aligned_deadline(entry->m_period, clock_type::now());
+                target.m_timeline.push(entry->m_deadline, entry->m_id);
+                target.m_routines.emplace(entry->m_id, entry);
+            }
+
+            // the new routine may be due before the current earliest deadline
+            target.m_wakeable.signal();
+
+            return entry->m_id;
+        }
+
+        /**
+         * @brief Unregisters a periodic routine.
+         *
+         * Note: if the routine is currently running, this call does not wait for its completion.
+         *
+         * @param id Identifier returned by @ref add.
+         * @return true if the routine was found and removed.
+         */
+        bool remove(routine_id id)
+        {
+            std::lock_guard<std::mutex> registry_guard(m_registry_mutex);
+
+            auto found = m_routine_lane.find(id);
+            if (found == m_routine_lane.end())
+            {
+                return false;
+            }
+
+            lane& target = *found->second;
+            m_routine_lane.erase(found);
+
+            std::lock_guard<std::mutex> guard(target.m_mutex);
+            auto entry = target.m_routines.find(id);
+            if (entry != target.m_routines.end())
+            {
+                target.m_load -= 1.0 / static_cast<double>(entry->second->m_period.count());
+                // the pending deadline in the timeline is discarded lazily
+                target.m_routines.erase(entry);
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Returns the number of registered routines.
+         */
+        [[nodiscard]] std::size_t size() const
+        {
+            std::lock_guard<std::mutex> registry_guard(m_registry_mutex);
+            return m_routine_lane.size();
+        }
+
+        /**
+         * @brief Returns the number of hosting threads.
+         */
+        [[nodiscard]] std::size_t nb_threads() const
+        {
+            return m_lanes.size();
+        }
+
+        /**
+         * @brief Returns the number of wakeups which executed at least one routine.
+         *
+         * Harmonic ticks due at the same time point are executed in the same wakeup.
+         */
+        [[nodiscard]] std::uint64_t wakeup_count() const
+        {
+            std::uint64_t total = 0U;
+            for (const auto& lane_ptr : m_lanes)
+            {
+                total += lane_ptr->m_wakeups.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+    private:
+        struct routine_entry
+        {
+            call_back m_routine;
+            std::shared_ptr<Context> m_context;
+            std::string m_task_name;
+            std::chrono::duration<int, std::micro> m_period = {};
+            clock_type::time_point m_deadline = {};
+            routine_id m_id = 0U;
+        };
+
+        using entry_ptr = std::shared_ptr<routine_entry>;
+
+        struct lane
+        {
+            std::mutex m_mutex;
+            tools::sync_object m_wakeable = {};
+            tools::time_list<clock_type::time_point, routine_id> m_timeline;
+            std::unordered_map<routine_id, entry_ptr> m_routines;
+            double m_load = 0.0;
+            std::atomic<std::uint64_t> m_wakeups = 0U;
+            std::unique_ptr<std::thread> m_task = {};
+        };
+
+        // below this remaining time the lane actively waits for the deadline
+        static constexpr auto active_wait_threshold = std::chrono::microseconds(50);
+
+        // when no routine is registered, the lane still polls the stop flag
+        static constexpr auto idle_timeout = std::chrono::duration<int, std::micro>(100000);
+
+        // sleep 90% of the remaining time, then re-evaluate (an earlier routine may have been added)
+        static constexpr double sleep_ratio = 0.9;
+
+        [[nodiscard]] clock_type::time_point next_aligned_deadline(
+            const std::chrono::duration<int, std::micro>& period, clock_type::time_point after) const
+        {
+            // smallest epoch + k * period strictly greater than 'after'
+            const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(after - m_epoch);
+            const auto nb_periods = (elapsed.count() / period.count()) + 1;
+            return m_epoch + std::chrono::microseconds(nb_periods * period.count());
+        }
+
+        void lane_loop(lane& current_lane)
+        {
+            std::vector<entry_ptr> due_routines;
+
+            while (!m_stop_task.load())
+            {
+                std::optional<clock_type::time_point> earliest_deadline;
+                {
+                    std::lock_guard<std::mutex> guard(current_lane.m_mutex);
+                    const auto top = current_lane.m_timeline.top();
+                    if (top.has_value())
+                    {
+                        earliest_deadline = top->first;
+                    }
+                }
+
+                if (!earliest_deadline.has_value())
+                {
+                    current_lane.m_wakeable.wait_for_signal(idle_timeout);
+                    continue;
+                }
+
+                auto current_time = clock_type::now();
+                if (*earliest_deadline > current_time)
+                {
+                    const auto remaining_time
+                        = std::chrono::duration_cast<std::chrono::microseconds>(*earliest_deadline - current_time);
+
+                    if (remaining_time > active_wait_threshold)
+                    {
+                        const auto sleep_time = std::chrono::duration<int, std::micro>(
+                            static_cast<int>(sleep_ratio * static_cast<double>(remaining_time.count())));
+                        current_lane.m_wakeable.wait_for_signal(sleep_time);
+                        continue;
+                    }
+
+                    // active wait loop
+                    do
+                    {
+                        current_time = clock_type::now();
+                    } while (*earliest_deadline > current_time);
+                }
+
+                collect_due_routines(current_lane, current_time, due_routines);
+
+                if (due_routines.empty())
+                {
+                    continue;
+                }
+
+                if (m_rate_monotonic)
+                {
+                    // shortest period first
+                    std::stable_sort(due_routines.begin(), due_routines.end(),
+                        [](const entry_ptr& lhs, const entry_ptr& rhs) { return lhs->m_period < rhs->m_period; });
+                }
+
+                for (const auto& entry : due_routines)
+                {
+                    entry->m_routine(entry->m_context, entry->m_task_name);
+                }
+
+                current_lane.m_wakeups.fetch_add(1U, std::memory_order_relaxed);
+
+                reschedule_routines(current_lane, due_routines);
+                due_routines.clear();
+            } // lane loop
+        }
+
+        void collect_due_routines(
+            lane& current_lane, clock_type::time_point current_time, std::vector<entry_ptr>& due_routines)
+        {
+            std::lock_guard<std::mutex> guard(current_lane.m_mutex);
+
+            auto top = current_lane.m_timeline.top();
+            while (top.has_value() && (top->first <= current_time))
+            {
+                current_lane.m_timeline.pop();
+
+                auto found = current_lane.m_routines.find(top->second);
+                // skip deadlines of removed routines
+                if ((found != current_lane.m_routines.end()) && (found->second->m_deadline == top->first))
+                {
+                    due_routines.push_back(found->second);
+                }
+
+                top = current_lane.m_timeline.top();
+            }
+        }
+
+        void reschedule_routines(lane& current_lane, const std::vector<entry_ptr>& due_routines)
+        {
+            const auto current_time = clock_type::now();
+
+            std::lock_guard<std::mutex> guard(current_lane.m_mutex);
+
+            for (const auto& entry : due_routines)
+            {
+                if (current_lane.m_routines.find(entry->m_id) == current_lane.m_routines.end())
+                {
+                    continue; // removed while running
+                }
+
+                entry->m_deadline += entry->m_period;
+
+                if (entry->m_deadline <= current_time)
+                {
+                    // overrun: skip missed ticks and stay aligned on the period grid
+                    entry->m_deadline = next_aligned_deadline(entry->m_period, current_time);
+                }
+
+                current_lane.m_timeline.push(entry->m_deadline, entry->m_id);
+            }
+        }
+
+        std::string m_scheduler_name;
+        bool m_rate_monotonic = true;
+        clock_type::time_point m_epoch;
+        std::vector<std::unique_ptr<lane>> m_lanes;
+        std::unordered_map<routine_id, lane*> m_routine_lane;
+        mutable std::mutex m_registry_mutex;
+        std::atomic<routine_id> m_next_id = 1U;
+        std::atomic_bool m_stop_task = false;
+    };
+}
+
+#endif //  PERIODIC_SCHEDULER_HPP_
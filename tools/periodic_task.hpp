@@ -39,20 +39,76 @@
 #if !defined(PERIODIC_TASK_HPP_)
 #define PERIODIC_TASK_HPP_
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
+#include <optional>
 #include <string>
 #include <thread>
 #include <type_traits>
 #include <utility>
 
+#include "tools/linux/linux_realtime_profile.hpp"
 #include "tools/linux/linux_sched_deadline.hpp"
 #include "tools/non_copyable.hpp"
 
 namespace tools
 {
+    /**
+     * @brief Behaviour of a periodic task when a tick ends after the next deadline.
+     */
+    enum class periodic_overrun_policy
+    {
+        catch_up,    // keep the original deadlines, late ticks run back-to-back until caught up
+        skip_missed, // drop the missed ticks, next deadline stays on the original period grid
+        rephase      // restart the period grid from the end of the late tick
+    };
+
+    /**
+     * @brief Snapshot of the timing statistics of a periodic task.
+     *
+     * Histograms use power of 2 buckets in microseconds: bucket 0 counts 0 us,
+     * bucket i counts values in [2^(i-1), 2^i) us, the last bucket also counts
+     * all greater values.
+     */
+    struct periodic_task_stats
+    {
+        static constexpr std::size_t histogram_buckets = 32U;
+
+        std::uint64_t ticks = 0U;            // number of executed ticks
+        std::uint64_t overruns = 0U;         // ticks whose routine ran longer than the period
+        std::uint64_t missed_deadlines = 0U; // ticks ending after the next deadline
+        std::uint64_t skipped_ticks = 0U;    // ticks dropped by the skip_missed policy
+        std::chrono::microseconds max_lateness = {};
+        std::chrono::microseconds max_duration = {};
+        std::array<std::uint64_t, histogram_buckets> lateness_histogram = {};
+        std::array<std::uint64_t, histogram_buckets> duration_histogram = {};
+
+        [[nodiscard]] static constexpr std::size_t bucket_index(std::int64_t value_us)
+        {
+            std::size_t idx = 0U;
+            auto value = static_cast<std::uint64_t>(std::max<std::int64_t>(value_us, 0));
+            while ((value != 0U) && (idx < (histogram_buckets - 1U)))
+            {
+                value >>= 1U;
+                ++idx;
+            }
+            return idx;
+        }
+
+        // exclusive upper bound (in us) of the given bucket
+        [[nodiscard]] static constexpr std::uint64_t bucket_upper_bound(std::size_t idx)
+        {
+            return (1ULL << idx);
+        }
+    };
+
     /**
      * @brief Class representing a periodic task.
      *
@@ -79,11 +135,15 @@ namespace tools
                          && std::is_constructible_v<std::shared_ptr<Context>, ContextArg&&>
                          && std::is_constructible_v<std::string, NameArg&&>
         periodic_task(RoutineArg&& routine, ContextArg&& context, NameArg&& task_name,
-            const std::chrono::duration<int, std::micro>& period)
+            const std::chrono::duration<int, std::micro>& period,
+            periodic_overrun_policy overrun_policy = periodic_overrun_policy::catch_up,
+            const std::optional<realtime_profile>& rt_profile = std::nullopt)
             : m_routine { std::forward<RoutineArg>(routine) }
             , m_context { std::forward<ContextArg>(context) }
             , m_task_name { std::forward<NameArg>(task_name) }
             , m_period { period }
+            , m_overrun_policy { overrun_policy }
+            , m_realtime_profile { rt_profile }
             , m_task { std::make_unique<std::thread>([this]() { periodic_call(); }) }
         {
         }
@@ -94,11 +154,15 @@ namespace tools
                 && std::is_constructible_v<std::shared_ptr<Context>, ContextArg&&>
                 && std::is_constructible_v<std::string, NameArg&&>>>
         periodic_task(RoutineArg&& routine, ContextArg&& context, NameArg&& task_name,
-            const std::chrono::duration<int, std::micro>& period)
+            const std::chrono::duration<int, std::micro>& period,
+            periodic_overrun_policy overrun_policy = periodic_overrun_policy::catch_up,
+            const std::optional<realtime_profile>& rt_profile = std::nullopt)
             : m_routine { std::forward<RoutineArg>(routine) }
             , m_context { std::forward<ContextArg>(context) }
             , m_task_name { std::forward<NameArg>(task_name) }
             , m_period { period }
+            , m_overrun_policy { overrun_policy }
+            , m_realtime_profile { rt_profile }
             , m_task { std::make_unique<std::thread>([this]() { periodic_call(); }) }
         {
         }
@@ -110,13 +174,54 @@ namespace tools
             m_task->join();
         }
 
+        /**
+         * @brief Returns a snapshot of the tick lateness/routine duration statistics.
+         *
+         * Counters are updated with relaxed atomics by the periodic thread, the snapshot
+         * is consistent per counter but not across counters.
+         */
+        [[nodiscard]] periodic_task_stats stats() const
+        {
+            periodic_task_stats snapshot;
+            snapshot.ticks = m_ticks.load(std::memory_order_relaxed);
+            snapshot.overruns = m_overruns.load(std::memory_order_relaxed);
+            snapshot.missed_deadlines = m_missed_deadlines.load(std::memory_order_relaxed);
+            snapshot.skipped_ticks = m_skipped_ticks.load(std::memory_order_relaxed);
+            snapshot.max_lateness = std::chrono::microseconds(m_max_lateness_us.load(std::memory_order_relaxed));
+            snapshot.max_duration = std::chrono::microseconds(m_max_duration_us.load(std::memory_order_relaxed));
+
+            for (std::size_t i = 0U; i < periodic_task_stats::histogram_buckets; ++i)
+            {
+                snapshot.lateness_histogram[i] = m_lateness_histogram[i].load(std::memory_order_relaxed);
+                snapshot.duration_histogram[i] = m_duration_histogram[i].load(std::memory_order_relaxed);
+            }
+
+            return snapshot;
+        }
+
+        [[nodiscard]] periodic_overrun_policy overrun_policy() const
+        {
+            return m_overrun_policy;
+        }
+
+        /**
+         * @brief Returns the real-time settings which took effect on the periodic thread.
+         *
+         * Without explicit profile, only the legacy SCHED_DEADLINE attempt is reported.
+         * Blocks until the periodic thread has applied its scheduling settings.
+         */
+        [[nodiscard]] realtime_report realtime_status() const
+        {
+            return m_realtime_report.get();
+        }
+
     private:
         void periodic_call()
         {
             const auto start_time = std::chrono::high_resolution_clock::now();
             auto deadline = start_time + m_period;
 
-            const auto earliest_deadline_enabled = set_earliest_deadline_scheduling(start_time, m_period);
+            const auto earliest_deadline_enabled = apply_scheduling(start_time);
 
             while (!m_stop_task.load())
             {
@@ -130,10 +235,19 @@ namespace tools
                 // execute given periodic function
                 m_routine(m_context, m_task_name);
 
+                const auto tick_start = current_time;
+                current_time = std::chrono::high_resolution_clock::now();
+                record_tick(tick_start - deadline, current_time - tick_start);
+
                 // compute next deadline
                 deadline += m_period;
 
-                current_time = std::chrono::high_resolution_clock::now();
+                if (deadline <= current_time)
+                {
+                    // the routine ended after the next deadline
+                    m_missed_deadlines.fetch_add(1U, std::memory_order_relaxed);
+                    deadline = apply_overrun_policy(deadline, current_time);
+                }
 
                 // wait period
                 if (deadline > current_time)
@@ -152,10 +266,104 @@ namespace tools
             } // periodic task loop
         }
 
+        bool apply_scheduling(std::chrono::high_resolution_clock::time_point start_time)
+        {
+            realtime_report report;
+
+            if (m_realtime_profile.has_value())
+            {
+                // the deadline and period of the budget default to the task period
+                auto profile = *m_realtime_profile;
+                if (profile.period.count() <= 0)
+                {
+                    profile.period = m_period;
+                }
+                if (profile.deadline.count() <= 0)
+                {
+                    profile.deadline = profile.period;
+                }
+
+                report = apply_realtime_profile(profile);
+            }
+            else if (set_earliest_deadline_scheduling(start_time, m_period))
+            {
+                report.applied_policy = realtime_policy::deadline;
+            }
+
+            m_realtime_promise.set_value(report);
+
+            return (realtime_policy::deadline == report.applied_policy);
+        }
+
+        [[nodiscard]] std::chrono::high_resolution_clock::time_point apply_overrun_policy(
+            std::chrono::high_resolution_clock::time_point deadline,
+            std::chrono::high_resolution_clock::time_point current_time)
+        {
+            switch (m_overrun_policy)
+            {
+                case periodic_overrun_policy::skip_missed:
+                {
+                    // jump to the first deadline of the original grid that is still ahead
+                    const auto late = std::chrono::duration_cast<std::chrono::microseconds>(current_time - deadline);
+                    const auto missed = (late.count() / m_period.count()) + 1;
+                    m_skipped_ticks.fetch_add(static_cast<std::uint64_t>(missed), std::memory_order_relaxed);
+                    return deadline + std::chrono::microseconds(missed * m_period.count());
+                }
+
+                case periodic_overrun_policy::rephase:
+                    return current_time + m_period;
+
+                case periodic_overrun_policy::catch_up:
+                default:
+                    return deadline;
+            }
+        }
+
+        void record_tick(std::chrono::high_resolution_clock::duration lateness,
+            std::chrono::high_resolution_clock::duration duration)
+        {
+            const auto lateness_us = std::chrono::duration_cast<std::chrono::microseconds>(lateness).count();
+            const auto duration_us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+
+            m_ticks.fetch_add(1U, std::memory_order_relaxed);
+            m_lateness_histogram[periodic_task_stats::bucket_index(lateness_us)].fetch_add(
+                1U, std::memory_order_relaxed);
+            m_duration_histogram[periodic_task_stats::bucket_index(duration_us)].fetch_add(
+                1U, std::memory_order_relaxed);
+
+            if (duration_us > m_period.count())
+            {
+                m_overruns.fetch_add(1U, std::memory_order_relaxed);
+            }
+
+            // single writer: no CAS loop needed
+            if (lateness_us > m_max_lateness_us.load(std::memory_order_relaxed))
+            {
+                m_max_lateness_us.store(lateness_us, std::memory_order_relaxed);
+            }
+
+            if (duration_us > m_max_duration_us.load(std::memory_order_relaxed))
+            {
+                m_max_duration_us.store(duration_us, std::memory_order_relaxed);
+            }
+        }
+
         call_back m_routine;
         std::shared_ptr<Context> m_context;
         std::string m_task_name;
         std::chrono::duration<int, std::micro> m_period;
+        periodic_overrun_policy m_overrun_policy = periodic_overrun_policy::catch_up;
+        std::optional<realtime_profile> m_realtime_profile;
+        std::promise<realtime_report> m_realtime_promise = {};
+        std::shared_future<realtime_report> m_realtime_report = m_realtime_promise.get_future().share();
+        std::atomic<std::uint64_t> m_ticks = 0U;
+        std::atomic<std::uint64_t> m_overruns = 0U;
+        std::atomic<std::uint64_t> m_missed_deadlines = 0U;
+        std::atomic<std::uint64_t> m_skipped_ticks = 0U;
+        std::atomic<std::int64_t> m_max_lateness_us = 0;
+        std::atomic<std::int64_t> m_max_duration_us = 0;
+        std::array<std::atomic<std::uint64_t>, periodic_task_stats::histogram_buckets> m_lateness_histogram = {};
+        std::array<std::atomic<std::uint64_t>, periodic_task_stats::histogram_buckets> m_duration_histogram = {};
         std::unique_ptr<std::thread> m_task = {};
         std::atomic_bool m_stop_task = false;
     };
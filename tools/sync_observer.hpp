@@ -43,11 +43,13 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "tools/non_copyable.hpp"
 
@@ -72,12 +74,20 @@ namespace tools
     template <typename Topic, typename Evt>
     using loose_coupled_handler = std::function<void(const Topic&, const Evt&, const std::string&)>;
 
-    template <typename Topic, typename Evt>
+    /**
+     * @brief Subject dispatching published events to its observers and handlers.
+     *
+     * @tparam Topic The type of the topic associated with the events.
+     * @tparam Evt The type of the event data.
+     * @tparam Allocator The allocator of the subscriber maps and publish scratch storage, rebound per container.
+     */
+    template <typename Topic, typename Evt, typename Allocator = std::allocator<std::byte>>
     class sync_subject : public non_copyable // NOLINT inherits from non copyable and non movable class
     {
     public:
         using sync_observer_shared_ptr = std::shared_ptr<sync_observer<Topic, Evt>>;
         using handler = loose_coupled_handler<Topic, Evt>;
+        using allocator_type = Allocator;
 
         sync_subject() = delete;
         sync_subject(const std::string& name)
@@ -85,6 +95,15 @@ namespace tools
         {
         }
 
+        // subscriber maps and publish scratch storage allocated with the given allocator (e.g. a
+        // std::pmr::memory_resource* for a pmr_sync_subject)
+        sync_subject(const std::string& name, const Allocator& alloc)
+            : m_subscribers { subscriber_allocator(alloc) }
+            , m_handlers { handler_allocator(alloc) }
+            , m_name { name }
+        {
+        }
+
         virtual ~sync_subject() = default;
 
         [[nodiscard]] std::string name() const
@@ -181,8 +200,9 @@ namespace tools
 
         virtual void publish(const Topic& topic, const Evt& event) const
         {
-            std::vector<sync_observer_shared_ptr> to_inform;
-            std::vector<handler> to_invoke;
+            std::vector<sync_observer_shared_ptr, rebind_alloc<sync_observer_shared_ptr>> to_inform(
+                rebind_alloc<sync_observer_shared_ptr>(m_subscribers.get_allocator()));
+            std::vector<handler, rebind_alloc<handler>> to_invoke(rebind_alloc<handler>(m_handlers.get_allocator()));
 
             {
                 std::shared_lock guard(m_mutex);
@@ -210,12 +230,26 @@ namespace tools
         }
 
     private:
+        template <typename U>
+        using rebind_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+        using subscriber_allocator = rebind_alloc<std::pair<const Topic, sync_observer_shared_ptr>>;
+        using handler_allocator = rebind_alloc<std::pair<const Topic, std::pair<std::string, handler>>>;
+
         mutable std::shared_mutex m_mutex;
-        std::multimap<Topic, sync_observer_shared_ptr> m_subscribers = {};
-        std::multimap<Topic, std::pair<std::string, handler>> m_handlers = {};
+        std::multimap<Topic, sync_observer_shared_ptr, std::less<Topic>, subscriber_allocator> m_subscribers = {};
+        std::multimap<Topic, std::pair<std::string, handler>, std::less<Topic>, handler_allocator> m_handlers = {};
         std::string m_name;
     };
 
+    /**
+     * @brief A sync_subject whose subscriber maps and publish scratch storage come from a std::pmr::memory_resource.
+     *
+     * @tparam Topic The type of the topic associated with the events.
+     * @tparam Evt The type of the event data.
+     */
+    template <typename Topic, typename Evt>
+    using pmr_sync_subject = sync_subject<Topic, Evt, std::pmr::polymorphic_allocator<std::byte>>;
+
 }
 
 #endif //  SYNC_OBSERVER_HPP_
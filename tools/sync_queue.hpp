@@ -39,6 +39,9 @@
 #if !defined(SYNC_QUEUE_HPP_)
 #define SYNC_QUEUE_HPP_
 
+#include <deque>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <optional>
 #include <queue>
@@ -62,14 +65,31 @@ namespace tools
      * It inherits from non_copyable to prevent copying and moving.
      *
      * @tparam T The type of elements stored in the queue.
+     * @tparam Container The underlying container used by std::queue.
      */
-    template <typename T>
+    template <typename T, typename Container = std::deque<T>>
     class sync_queue : public non_copyable // NOLINT inherits from non copyable/non movable
     {
     public:
         sync_queue() = default;
         ~sync_queue() = default;
 
+        // allocator aware construction (e.g. a std::pmr::memory_resource* for a pmr container)
+#if (__cplusplus >= 202002L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L))
+        template <typename Alloc>
+            requires std::uses_allocator_v<Container, Alloc>
+        explicit sync_queue(const Alloc& alloc)
+            : m_queue(alloc)
+        {
+        }
+#else
+        template <typename Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+        explicit sync_queue(const Alloc& alloc)
+            : m_queue(alloc)
+        {
+        }
+#endif
+
         void push(const T& elem)
         {
             std::unique_lock guard(m_mutex);
@@ -220,9 +240,17 @@ namespace tools
         }
 
     private:
-        std::queue<T> m_queue;
+        std::queue<T, Container> m_queue;
         mutable std::shared_mutex m_mutex;
     };
+
+    /**
+     * @brief A thread-safe queue whose storage comes from a std::pmr::memory_resource.
+     *
+     * @tparam T The type of elements stored in the queue.
+     */
+    template <typename T>
+    using pmr_sync_queue = sync_queue<T, std::pmr::deque<T>>;
 }
 
 #endif //  SYNC_QUEUE_HPP_
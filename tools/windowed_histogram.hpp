@@ -0,0 +1,161 @@
+/**
+ * @file windowed_histogram.hpp
+ * @brief Sliding time-window histogram (ring of log-linear histogram slices).
+ * @author Laurent Lardinois
+ * @date October 2026
+ */
+
+//-----------------------------------------------------------------------------//
+// C++ Publish/Subscribe Pattern - Spare time development for fun              //
+// (c) 2025-2026 Laurent Lardinois https://be.linkedin.com/in/laurentlardinois //
+//                                                                             //
+// https://github.com/type-one/PublishSubscribe                                //
+//                                                                             //
+// MIT License                                                                 //
+//                                                                             //
+// This software is provided 'as-is', without any express or implied           //
+// warranty.In no event will the authors be held liable for any damages        //
+// arising from the use of this software.                                      //
+//                                                                             //
+// Permission is granted to anyone to use this software for any purpose,       //
+// including commercial applications, and to alter itand redistribute it       //
+// freely, subject to the following restrictions :                             //
+//                                                                             //
+// 1. The origin of this software must not be misrepresented; you must not     //
+// claim that you wrote the original software.If you use this software         //
+// in a product, an acknowledgment in the product documentation would be       //
+// appreciated but is not required.                                            //
+// 2. Altered source versions must be plainly marked as such, and must not be  //
+// misrepresented as being the original software.                              //
+// 3. This notice may not be removed or altered from any source distribution.  //
+//-----------------------------------------------------------------------------//
+
+#pragma once
+
+#if !defined(WINDOWED_HISTOGRAM_HPP_)
+#define WINDOWED_HISTOGRAM_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "tools/hdr_histogram.hpp"
+#include "tools/non_copyable.hpp"
+
+namespace tools
+{
+    /**
+     * @brief Thread-safe histogram over a sliding time window, without storing raw samples.
+     *
+     * The window is a ring of hdr_histogram slices of a fixed duration. Samples go to the
+     * current slice and rotate() (typically called by a periodic_task every slice duration)
+     * moves to the next slice, dropping the oldest one. Window queries merge the slices
+     * covering the requested duration, O(buckets) per slice.
+     */
+    class windowed_histogram : public non_copyable // NOLINT inherits from non copyable/non movable
+    {
+    public:
+        struct thread_safe
+        {
+            static constexpr bool value = true;
+        };
+
+        windowed_histogram() = delete;
+
+        /**
+         * @param slice_duration Duration covered by one slice (the rotation period).
+         * @param nb_slices Number of slices, the longest window is nb_slices * slice_duration.
+         * @param highest_trackable_value Values above are clamped (see hdr_histogram).
+         * @param precision_bits Sub-bucket bits (see hdr_histogram).
+         */
+        windowed_histogram(const std::chrono::duration<int, std::micro>& slice_duration, std::size_t nb_slices,
+            std::uint64_t highest_trackable_value = hdr_histogram::default_highest_trackable_value,
+            int precision_bits = hdr_histogram::default_precision_bits)
+            : m_slice_duration { std::max(slice_duration, std::chrono::duration<int, std::micro>(1)) }
+            , m_slices(std::max<std::size_t>(nb_slices, 1U), hdr_histogram { highest_trackable_value, precision_bits })
+        {
+        }
+
+        ~windowed_histogram() = default;
+
+        void record(std::uint64_t value, std::uint64_t count = 1U)
+        {
+            std::lock_guard guard(m_mutex);
+            m_slices[m_current].record(value, count);
+        }
+
+        /**
+         * @brief Starts a new slice, the oldest slice leaves the window.
+         */
+        void rotate()
+        {
+            std::lock_guard guard(m_mutex);
+            m_current = (m_current + 1U) % m_slices.size();
+            m_slices[m_current].reset();
+            ++m_rotations;
+        }
+
+        /**
+         * @brief Merges the slices covering the given duration (current slice included).
+         *
+         * @param window Duration of the window, rounded up to whole slices and bounded by the ring.
+         */
+        [[nodiscard]] hdr_histogram snapshot(const std::chrono::duration<int, std::micro>& window) const
+        {
+            const auto nb_slices = static_cast<std::size_t>(
+                (window.count() + m_slice_duration.count() - 1) / m_slice_duration.count());
+            return snapshot_slices(std::max<std::size_t>(nb_slices, 1U));
+        }
+
+        /**
+         * @brief Merges the whole ring.
+         */
+        [[nodiscard]] hdr_histogram snapshot() const
+        {
+            return snapshot_slices(m_slices.size());
+        }
+
+        [[nodiscard]] std::chrono::duration<int, std::micro> slice_duration() const
+        {
+            return m_slice_duration;
+        }
+
+        [[nodiscard]] std::size_t slice_count() const
+        {
+            return m_slices.size();
+        }
+
+        [[nodiscard]] std::uint64_t rotations() const
+        {
+            std::lock_guard guard(m_mutex);
+            return m_rotations;
+        }
+
+    private:
+        [[nodiscard]] hdr_histogram snapshot_slices(std::size_t nb_slices) const
+        {
+            std::lock_guard guard(m_mutex);
+
+            nb_slices = std::min(nb_slices, m_slices.size());
+            hdr_histogram merged = m_slices[m_current];
+
+            for (std::size_t i = 1U; i < nb_slices; ++i)
+            {
+                merged.merge(m_slices[(m_current + m_slices.size() - i) % m_slices.size()]);
+            }
+
+            return merged;
+        }
+
+        std::chrono::duration<int, std::micro> m_slice_duration;
+        std::vector<hdr_histogram> m_slices;
+        std::size_t m_current = 0U;
+        std::uint64_t m_rotations = 0U;
+        mutable std::mutex m_mutex;
+    };
+}
+
+#endif //  WINDOWED_HISTOGRAM_HPP_
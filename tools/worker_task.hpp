@@ -57,12 +57,14 @@
 #include <pthread.h>
 #endif
 
+#include "tools/linux/linux_realtime_profile.hpp"
 #include "tools/non_copyable.hpp"
 #include "tools/sync_object.hpp"
 #include "tools/sync_queue.hpp"
 
 #include "portable_concurrency/p_execution.hpp"
 #include "portable_concurrency/p_future.hpp"
+#include "portable_concurrency/p_stop_token.hpp"
 
 namespace tools
 {
@@ -92,6 +94,9 @@ namespace tools
 
         template <typename Ctx, typename Task>
         friend void post(worker_task_executor<Ctx> exec, Task&& task);
+
+        template <typename Ctx>
+        friend bool running_in_this_thread(const worker_task_executor<Ctx>& exec) noexcept;
     };
 
     /**
@@ -114,6 +119,22 @@ namespace tools
             [shared_task](std::shared_ptr<Context>, const std::string&) mutable { (*shared_task)(); });
     }
 
+    /**
+     * @brief Tells whether the calling thread is the worker thread owned by the executor.
+     *
+     * Found by ADL from portable_concurrency: a continuation scheduled on this executor
+     * from the worker thread itself runs in place instead of going through the queue.
+     *
+     * @tparam Context The worker context type.
+     * @param exec Executor handle that identifies the worker.
+     * @return true when called from the worker thread.
+     */
+    template <typename Context>
+    bool running_in_this_thread(const worker_task_executor<Context>& exec) noexcept
+    {
+        return exec.m_owner->is_current_thread();
+    }
+
     /**
      * @brief A worker task class template.
      *
@@ -188,6 +209,12 @@ namespace tools
 #endif
         }
 
+        // true when called from the worker thread itself
+        [[nodiscard]] bool is_current_thread() const noexcept
+        {
+            return m_task->get_id() == std::this_thread::get_id();
+        }
+
         // rvalue overload: enqueue a pre-built std::function by move.
         void delegate(call_back&& work)
         {
@@ -251,6 +278,32 @@ namespace tools
                 as_executor(), std::forward<Callable>(work), m_context, m_task_name, std::forward<Args>(args)...);
         }
 
+        // Cancellable variant: the job is skipped (future holding operation_cancelled) if a stop was
+        // requested through the token before the worker dequeued it; a running job may poll the token.
+        template <typename Callable, typename... Args>
+        auto delegate_async(portable_concurrency::stop_token token, Callable&& work, Args&&... args)
+            -> decltype(portable_concurrency::async(std::declval<executor_type>(), std::move(token),
+                std::forward<Callable>(work), std::declval<std::shared_ptr<Context>>(), std::declval<std::string>(),
+                std::forward<Args>(args)...))
+        {
+            return portable_concurrency::async(as_executor(), std::move(token), std::forward<Callable>(work),
+                m_context, m_task_name, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Applies a real-time profile (scheduling policy, memory locking, prefaulting) to the worker thread.
+         *
+         * The profile is applied by a job queued on the worker, the returned future gives
+         * the settings which actually took effect.
+         */
+        [[nodiscard]] portable_concurrency::future<realtime_report> set_realtime_profile(const realtime_profile& profile)
+        {
+            return delegate_async(
+                [](const std::shared_ptr<Context>&, const std::string&, const realtime_profile& rt_profile)
+                { return apply_realtime_profile(rt_profile); },
+                profile);
+        }
+
 #if defined(PC_HAS_COROUTINES)
         /**
          * @brief Awaitable that resumes the awaiting coroutine on this worker thread.